@@ -51,6 +51,8 @@ ExecutableAllocator::sizeOfCode(size_t *method, size_t *regexp, size_t *unused)
         *regexp += pool->m_mjitCodeRegexp;
         *unused += pool->m_allocation.size - pool->m_mjitCodeMethod - pool->m_mjitCodeRegexp;
     }
+    for (size_t i = 0; i < m_cachedAllocations.length(); i++)
+        *unused += m_cachedAllocations[i].size;
 }
 
 }
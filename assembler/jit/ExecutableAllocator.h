@@ -27,6 +27,7 @@
 #define ExecutableAllocator_h
 
 #include <stddef.h> // for ptrdiff_t
+#include <string.h> // for memset
 #include <limits>
 
 #include "jsalloc.h"
@@ -128,6 +129,21 @@ public:
         }
     }
 
+    // Release a reference held by |n| bytes of code of the given kind. The
+    // bytes are accounted as unused from now on: they cannot be handed out
+    // again until the whole pool is released.
+    void release(size_t n, CodeKind kind)
+    {
+        if (kind == REGEXP_CODE) {
+            JS_ASSERT(n <= m_mjitCodeRegexp);
+            m_mjitCodeRegexp -= n;
+        } else {
+            JS_ASSERT(n <= m_mjitCodeMethod);
+            m_mjitCodeMethod -= n;
+        }
+        release();
+    }
+
 private:
     // It should be impossible for us to roll over, because only small
     // pools have multiple holders, and they have one holder per chunk
@@ -207,6 +223,8 @@ public:
     {
         for (size_t i = 0; i < m_smallPools.length(); i++)
             m_smallPools[i]->release(/* willDestroy = */true);
+        for (size_t i = 0; i < m_cachedAllocations.length(); i++)
+            systemRelease(m_cachedAllocations[i]);
         // XXX: temporarily disabled because it fails;  see bug 654820.
         //JS_ASSERT(m_pools.empty());     // if this asserts we have a pool leak
     }
@@ -240,7 +258,26 @@ public:
         JS_ASSERT(pool->m_allocation.pages);
         if (destroyCallback)
             destroyCallback(pool->m_allocation.pages, pool->m_allocation.size);
-        systemRelease(pool->m_allocation);
+
+        // Keep a few small pool allocations mapped, so that code which is
+        // repeatedly compiled and discarded does not unmap and map pages
+        // again each time. The allocator is shared by every compartment in
+        // the runtime, so the pages are cleared before they are cached:
+        // stale code must not be reachable from a pool handed to someone
+        // else. Clearing costs a write of each page, which is still cheaper
+        // than unmapping, remapping and faulting them back in.
+#ifndef DEBUG_STRESS_JSC_ALLOCATOR
+        if (canCacheAllocations() &&
+            pool->m_allocation.size == largeAllocSize &&
+            m_cachedAllocations.length() < maxCachedAllocations &&
+            m_cachedAllocations.append(pool->m_allocation))
+        {
+            clearAllocation(pool->m_allocation);
+        } else
+#endif
+        {
+            systemRelease(pool->m_allocation);
+        }
         m_pools.remove(m_pools.lookup(pool));   // this asserts if |pool| is not in m_pools
     }
 
@@ -281,6 +318,25 @@ private:
         return size;
     }
 
+    // A cached allocation is handed out again at the same address, which
+    // would defeat the address randomization systemAlloc performs when it
+    // is allowed to. Randomization wins: nothing is cached in that mode.
+    bool canCacheAllocations() const
+    {
+#if WTF_OS_WINDOWS
+        return allocBehavior != AllocationCanRandomize;
+#else
+        return true;
+#endif
+    }
+
+    static void clearAllocation(const ExecutablePool::Allocation& alloc)
+    {
+        makeWritable(alloc.pages, alloc.size);
+        memset(alloc.pages, 0, alloc.size);
+        makeExecutable(alloc.pages, alloc.size);
+    }
+
     // On OOM, this will return an Allocation where pages is NULL.
     ExecutablePool::Allocation systemAlloc(size_t n);
     static void systemRelease(const ExecutablePool::Allocation& alloc);
@@ -298,7 +354,11 @@ private:
 #ifdef DEBUG_STRESS_JSC_ALLOCATOR
         ExecutablePool::Allocation a = systemAlloc(size_t(4294967291));
 #else
-        ExecutablePool::Allocation a = systemAlloc(allocSize);
+        ExecutablePool::Allocation a;
+        if (allocSize == largeAllocSize && !m_cachedAllocations.empty())
+            a = m_cachedAllocations.popCopy();
+        else
+            a = systemAlloc(allocSize);
 #endif
         if (!a.pages)
             return NULL;
@@ -480,6 +540,12 @@ private:
     typedef js::Vector<ExecutablePool *, maxSmallPools, js::SystemAllocPolicy> SmallExecPoolVector;
     SmallExecPoolVector m_smallPools;
 
+    // Pages of released small pools, kept mapped for reuse by createPool().
+    static const size_t maxCachedAllocations = 4;
+    typedef js::Vector<ExecutablePool::Allocation, maxCachedAllocations, js::SystemAllocPolicy>
+            AllocationVector;
+    AllocationVector m_cachedAllocations;
+
     // All live pools are recorded here, just for stats purposes.  These are
     // weak references;  they don't keep pools alive.  When a pool is destroyed
     // its reference is removed from m_pools.
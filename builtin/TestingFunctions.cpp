@@ -11,9 +11,14 @@
 #include "jsgc.h"
 #include "jsobj.h"
 #include "jsprf.h"
+#include "jsstr.h"
 #include "jswrapper.h"
 
 #include "methodjit/MethodJIT.h"
+#ifdef JS_ION
+# include "ion/Ion.h"
+# include "ion/IonCompartment.h"
+#endif
 
 using namespace js;
 using namespace JS;
@@ -65,11 +70,12 @@ static const struct ParamPair {
     const char      *name;
     JSGCParamKey    param;
 } paramMap[] = {
-    {"maxBytes",            JSGC_MAX_BYTES },
-    {"maxMallocBytes",      JSGC_MAX_MALLOC_BYTES},
-    {"gcBytes",             JSGC_BYTES},
-    {"gcNumber",            JSGC_NUMBER},
-    {"sliceTimeBudget",     JSGC_SLICE_TIME_BUDGET}
+    {"maxBytes",                JSGC_MAX_BYTES },
+    {"maxMallocBytes",          JSGC_MAX_MALLOC_BYTES},
+    {"gcBytes",                 JSGC_BYTES},
+    {"gcNumber",                JSGC_NUMBER},
+    {"sliceTimeBudget",         JSGC_SLICE_TIME_BUDGET},
+    {"highFrequencyTimeLimit",  JSGC_HIGH_FREQUENCY_TIME_LIMIT}
 };
 
 static JSBool
@@ -446,6 +452,61 @@ static JSClass FinalizeCounterClass = {
     finalize_counter_finalize
 };
 
+static JSBool
+GCTriggerBytes(JSContext *cx, unsigned argc, jsval *vp)
+{
+    return JS_NewNumberValue(cx, double(cx->compartment->gcTriggerBytes), vp);
+}
+
+static JSBool
+GCStats(JSContext *cx, unsigned argc, jsval *vp)
+{
+    JSRuntime *rt = cx->runtime;
+    if (!rt->gcNumber) {
+        *vp = JSVAL_NULL;
+        return true;
+    }
+
+    jschar *chars = rt->gcStats.formatJSON(PRMJ_Now());
+    if (!chars) {
+        JS_ReportOutOfMemory(cx);
+        return false;
+    }
+
+    JSString *str = JS_NewUCString(cx, chars, js_strlen(chars));
+    if (!str) {
+        js_free(chars);
+        return false;
+    }
+
+    *vp = STRING_TO_JSVAL(str);
+    return true;
+}
+
+#ifdef JS_PROPERTY_CACHE_STATS
+static JSBool
+PropertyCacheStats(JSContext *cx, unsigned argc, jsval *vp)
+{
+    JSObject *obj = JS_NewObject(cx, NULL, NULL, NULL);
+    if (!obj)
+        return false;
+
+    const PropertyCache &cache = cx->runtime->propertyCache;
+    if (!JS_DefineProperty(cx, obj, "hits", DOUBLE_TO_JSVAL(double(cache.stats.hits)),
+                           NULL, NULL, JSPROP_ENUMERATE) ||
+        !JS_DefineProperty(cx, obj, "misses", DOUBLE_TO_JSVAL(double(cache.stats.misses)),
+                           NULL, NULL, JSPROP_ENUMERATE) ||
+        !JS_DefineProperty(cx, obj, "evictions", DOUBLE_TO_JSVAL(double(cache.stats.evictions)),
+                           NULL, NULL, JSPROP_ENUMERATE))
+    {
+        return false;
+    }
+
+    *vp = OBJECT_TO_JSVAL(obj);
+    return true;
+}
+#endif
+
 static JSBool
 MakeFinalizeObserver(JSContext *cx, unsigned argc, jsval *vp)
 {
@@ -488,6 +549,19 @@ MJitChunkLimit(JSContext *cx, unsigned argc, jsval *vp)
     return true;
 }
 
+static JSBool
+IonOsrRecompiles(JSContext *cx, unsigned argc, jsval *vp)
+{
+    JS_SET_RVAL(cx, vp, JSVAL_VOID);
+#ifdef JS_ION
+    if (ion::IsEnabled(cx)) {
+        ion::IonCompartment *ion = cx->compartment->ionCompartment();
+        JS_SET_RVAL(cx, vp, UINT_TO_JSVAL(ion ? ion->osrRecompiles() : 0));
+    }
+#endif
+    return true;
+}
+
 static JSBool
 Terminate(JSContext *cx, unsigned arg, jsval *vp)
 {
@@ -505,7 +579,25 @@ static JSFunctionSpecWithHelp TestingFunctions[] = {
     JS_FN_HELP("gcparam", GCParameter, 2, 0,
 "gcparam(name [, value])",
 "  Wrapper for JS_[GS]etGCParameter. The name is either maxBytes,\n"
-"  maxMallocBytes, gcBytes, gcNumber, or sliceTimeBudget."),
+"  maxMallocBytes, gcBytes, gcNumber, sliceTimeBudget, or\n"
+"  highFrequencyTimeLimit."),
+
+    JS_FN_HELP("gcTriggerBytes", GCTriggerBytes, 0, 0,
+"gcTriggerBytes()",
+"  Return the heap size of the current compartment at which its next GC is\n"
+"  triggered."),
+
+    JS_FN_HELP("gcstats", GCStats, 0, 0,
+"gcstats()",
+"  Return the statistics of the most recent GC as a JSON string, in the same\n"
+"  format given to GC slice callbacks, or null if no GC has run yet."),
+
+#ifdef JS_PROPERTY_CACHE_STATS
+    JS_FN_HELP("propertyCacheStats", PropertyCacheStats, 0, 0,
+"propertyCacheStats()",
+"  Return an object with the hits, misses and evictions counted by the\n"
+"  runtime's property cache since it was created. Debug builds only."),
+#endif
 
     JS_FN_HELP("countHeap", CountHeap, 0, 0,
 "countHeap([start[, kind]])",
@@ -567,6 +659,12 @@ static JSFunctionSpecWithHelp TestingFunctions[] = {
 "mjitChunkLimit(N)",
 "  Specify limit on compiled chunk size during mjit compilation."),
 
+    JS_FN_HELP("ionOsrRecompiles", IonOsrRecompiles, 0, 0,
+"ionOsrRecompiles()",
+"  Return how many times IonMonkey code in the current compartment was\n"
+"  thrown away to move its OSR entry to a different loop, or undefined if\n"
+"  IonMonkey is disabled."),
+
     JS_FN_HELP("terminate", Terminate, 0, 0,
 "terminate()",
 "  Terminate JavaScript execution, as if we had run out of\n"
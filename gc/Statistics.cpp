@@ -307,6 +307,7 @@ formatPhases(StatisticsSerializer &ss, const char *name, int64_t *times)
     ss.appendIfNonzeroMS("Sweep String", t(times[PHASE_SWEEP_STRING]));
     ss.appendIfNonzeroMS("Sweep Script", t(times[PHASE_SWEEP_SCRIPT]));
     ss.appendIfNonzeroMS("Sweep Shape", t(times[PHASE_SWEEP_SHAPE]));
+    ss.appendIfNonzeroMS("Sweep Ion Code", t(times[PHASE_SWEEP_IONCODE]));
     ss.appendIfNonzeroMS("Discard Code", t(times[PHASE_DISCARD_CODE]));
     ss.appendIfNonzeroMS("Discard Analysis", t(times[PHASE_DISCARD_ANALYSIS]));
     ss.appendIfNonzeroMS("Discard TI", t(times[PHASE_DISCARD_TI]));
@@ -347,9 +348,28 @@ Statistics::formatData(StatisticsSerializer &ss, uint64_t timestamp)
         ss.appendString("Nonincremental Reason",
                         nonincrementalReason ? nonincrementalReason : "none");
     }
+    /* The heap size after the GC is unknown until the helper has finished. */
+    bool swept = !sweepingInBackground;
+    size_t bytesAfter = postBytes;
+    int64_t sweepTime = 0;
+    {
+        AutoLockGC lock(runtime);
+        if (sweepingInBackground && backgroundSweepGCNumber == gcNumber) {
+            swept = true;
+            bytesAfter = backgroundSweepBytes;
+            sweepTime = backgroundSweepTime;
+        }
+    }
+
     ss.appendNumber("Allocated", "%u", "MB", unsigned(preBytes / 1024 / 1024));
+    if (ss.isJSON()) {
+        ss.appendNumber("Bytes Before", "%llu", "", (unsigned long long)preBytes);
+        if (swept)
+            ss.appendNumber("Bytes After", "%llu", "", (unsigned long long)bytesAfter);
+    }
     ss.appendNumber("+Chunks", "%d", "", counts[STAT_NEW_CHUNK]);
     ss.appendNumber("-Chunks", "%d", "", counts[STAT_DESTROY_CHUNK]);
+    ss.appendIfNonzeroMS("Background Sweep", t(sweepTime));
     ss.endLine();
 
     if (slices.length() > 1 || ss.isJSON()) {
@@ -409,7 +429,15 @@ Statistics::Statistics(JSRuntime *rt)
     gcDepth(0),
     collectedCount(0),
     compartmentCount(0),
-    nonincrementalReason(NULL)
+    nonincrementalReason(NULL),
+    gcNumber(0),
+    sweepingInBackground(false),
+    backgroundSweepGCNumber(0),
+    backgroundSweepTime(0),
+    backgroundSweepBytes(0),
+    backgroundSweepTotal(0),
+    preBytes(0),
+    postBytes(0)
 {
     PodArrayZero(phaseTotals);
     PodArrayZero(counts);
@@ -440,6 +468,7 @@ Statistics::~Statistics()
         if (fullFormat) {
             StatisticsSerializer ss(StatisticsSerializer::AsText);
             formatPhases(ss, "", phaseTotals);
+            ss.appendIfNonzeroMS("Background Sweep", t(backgroundSweepTotal));
             char *msg = ss.finishCString();
             if (msg) {
                 fprintf(fp, "TOTALS\n%s\n\n-------\n", msg);
@@ -486,8 +515,10 @@ Statistics::beginGC()
 
     slices.clearAndFree();
     nonincrementalReason = NULL;
+    sweepingInBackground = false;
 
     preBytes = runtime->gcBytes;
+    postBytes = preBytes;
 
     Probes::GCStart();
 }
@@ -495,6 +526,9 @@ Statistics::beginGC()
 void
 Statistics::endGC()
 {
+    gcNumber = runtime->gcNumber;
+    postBytes = runtime->gcBytes;
+
     Probes::GCEnd();
     crash::SnapshotGCStack();
 
@@ -106,6 +106,21 @@ struct Statistics {
         counts[s]++;
     }
 
+    /* Called when this GC leaves some finalization to the helper thread. */
+    void beginBackgroundSweep() { sweepingInBackground = true; }
+
+    /*
+     * Called by the helper thread, with the GC lock held, when it has
+     * finished finalizing for the GC numbered |gcNumber|. The time and heap
+     * size are reported with that GC once they are known.
+     */
+    void endBackgroundSweep(uint64_t gcNumber, int64_t time, size_t bytes) {
+        backgroundSweepGCNumber = gcNumber;
+        backgroundSweepTime = time;
+        backgroundSweepBytes = bytes;
+        backgroundSweepTotal += time;
+    }
+
     jschar *formatMessage();
     jschar *formatJSON(uint64_t timestamp);
 
@@ -153,11 +168,32 @@ struct Statistics {
     /* Total time in a given phase over all GCs. */
     int64_t phaseTotals[PHASE_LIMIT];
 
+    /* Number of this GC, taken when it ends. */
+    uint64_t gcNumber;
+
+    /* Whether this GC left some finalization to the helper thread. */
+    bool sweepingInBackground;
+
+    /*
+     * Time the helper thread spent finalizing for the GC numbered
+     * backgroundSweepGCNumber and the heap size when it finished, and the
+     * time over all GCs. Protected by the GC lock.
+     */
+    uint64_t backgroundSweepGCNumber;
+    int64_t backgroundSweepTime;
+    size_t backgroundSweepBytes;
+    int64_t backgroundSweepTotal;
+
     /* Number of events of this type for this GC. */
     unsigned int counts[STAT_LIMIT];
 
-    /* Allocated space before the GC started. */
+    /*
+     * Allocated space before the GC started and when its last slice ended.
+     * When finalization continues on the helper thread, the heap size after
+     * the GC is backgroundSweepBytes instead.
+     */
     size_t preBytes;
+    size_t postBytes;
 
     void beginGC();
     void endGC();
@@ -151,7 +151,8 @@ IonCompartment::IonCompartment()
     bailoutHandler_(NULL),
     argumentsRectifier_(NULL),
     invalidator_(NULL),
-    functionWrappers_(NULL)
+    functionWrappers_(NULL),
+    osrRecompiles_(0)
 {
 }
 
@@ -278,15 +279,16 @@ IonActivation::~IonActivation()
 }
 
 IonCode *
-IonCode::New(JSContext *cx, uint8 *code, uint32 bufferSize, JSC::ExecutablePool *pool)
+IonCode::New(JSContext *cx, uint8 *code, uint32 headerSize, uint32 bufferSize,
+             JSC::ExecutablePool *pool)
 {
     IonCode *codeObj = gc::NewGCThing<IonCode>(cx, gc::FINALIZE_IONCODE, sizeof(IonCode));
     if (!codeObj) {
-        pool->release();
+        pool->release(headerSize + bufferSize, JSC::METHOD_CODE);
         return NULL;
     }
 
-    new (codeObj) IonCode(code, bufferSize, pool);
+    new (codeObj) IonCode(code, headerSize, bufferSize, pool);
     return codeObj;
 }
 
@@ -337,7 +339,7 @@ IonCode::finalize(FreeOp *fop)
 {
     JS_ASSERT(!fop->onBackgroundThread());
     if (pool_)
-        pool_->release();
+        pool_->release(headerSize_ + bufferSize_, JSC::METHOD_CODE);
 }
 
 void
@@ -382,6 +384,7 @@ IonScript::IonScript()
     invalidateEpilogueOffset_(0),
     invalidateEpilogueDataOffset_(0),
     forbidOsr_(false),
+    osrPcMismatchCounter_(0),
     snapshots_(0),
     snapshotsSize_(0),
     bailoutTable_(0),
@@ -881,6 +884,24 @@ ion::CanEnterAtBranch(JSContext *cx, JSScript *script, StackFrame *fp, jsbytecod
     if (!js_IonOptions.osr)
         return Method_Skipped;
 
+    // If the script was compiled for another loop and this one keeps trying
+    // to enter, the hot loop has moved: throw away the old code and compile
+    // again with the entry at this loop. Code compiled for function entry
+    // has no OSR entry at all and is left alone.
+    if (script->ion && script->ion->osrPc() && script->ion->osrPc() != pc) {
+        if (script->ion->incrOsrPcMismatchCounter() <= js_IonOptions.osrPcMismatchesBeforeRecompile)
+            return Method_Skipped;
+
+        IonSpew(IonSpew_Invalidate, "Recompiling %s:%d for OSR at a different loop",
+                script->filename, script->lineno);
+
+        Vector<types::RecompileInfo> scripts(cx);
+        if (!scripts.append(types::RecompileInfo(script)))
+            return Method_Error;
+        Invalidate(cx->runtime->defaultFreeOp(), scripts, /* resetUses */ false);
+        cx->compartment->ionCompartment()->noteOsrRecompile();
+    }
+
     // Attempt compilation. Returns Method_Compiled if already compiled.
     MethodStatus status = Compile(cx, script, fp, pc);
     if (status != Method_Compiled) {
@@ -899,6 +920,7 @@ ion::CanEnterAtBranch(JSContext *cx, JSScript *script, StackFrame *fp, jsbytecod
     if (!script->ion)
         return Method_Skipped;
 
+    script->ion->resetOsrPcMismatchCounter();
     return Method_Compiled;
 }
 
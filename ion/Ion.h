@@ -102,6 +102,13 @@ struct IonOptions
     // Default: 10,240
     uint32 usesBeforeInlining;
 
+    // How many times a loop other than the one a script was compiled for may
+    // try to enter Ion code via OSR before the script is recompiled with its
+    // entry at that loop.
+    //
+    // Default: 1,000
+    uint32 osrPcMismatchesBeforeRecompile;
+
     void setEagerCompilation() {
         usesBeforeCompile = 0;
 
@@ -118,7 +125,8 @@ struct IonOptions
         inlining(true),
         rangeAnalysis(true),
         usesBeforeCompile(40),
-        usesBeforeInlining(10240)
+        usesBeforeInlining(10240),
+        osrPcMismatchesBeforeRecompile(1000)
     { }
 };
 
@@ -577,6 +577,9 @@ IonBuilder::snoopControlFlow(JSOp op)
       case JSOP_TABLESWITCH:
         return tableSwitch(op, info().getNote(cx, pc));
 
+      case JSOP_LOOKUPSWITCH:
+        return lookupSwitch(op, info().getNote(cx, pc));
+
       case JSOP_IFNE:
         // We should never reach an IFNE, it's a stopAt point, which will
         // trigger closing the loop.
@@ -952,6 +955,9 @@ IonBuilder::processCfgEntry(CFGState &state)
       case CFGState::TABLE_SWITCH:
         return processNextTableSwitchCase(state);
 
+      case CFGState::LOOKUP_SWITCH:
+        return processNextLookupSwitchCase(state);
+
       case CFGState::AND_OR:
         return processAndOrEnd(state);
 
@@ -1520,7 +1526,12 @@ IonBuilder::processSwitchBreak(JSOp op, jssrcnote *sn)
     JS_ASSERT(found);
     CFGState &state = *found;
 
-    state.tableswitch.breaks = new DeferredEdge(current, state.tableswitch.breaks);
+    if (state.state == CFGState::TABLE_SWITCH) {
+        state.tableswitch.breaks = new DeferredEdge(current, state.tableswitch.breaks);
+    } else {
+        JS_ASSERT(state.state == CFGState::LOOKUP_SWITCH);
+        state.lookupswitch.breaks = new DeferredEdge(current, state.lookupswitch.breaks);
+    }
 
     current = NULL;
     pc += js_CodeSpec[op].length;
@@ -1803,6 +1814,66 @@ IonBuilder::forLoop(JSOp op, jssrcnote *sn)
     return ControlStatus_Jumped;
 }
 
+IonBuilder::ControlStatus
+IonBuilder::processNextLookupSwitchCase(CFGState &state)
+{
+    JS_ASSERT(state.state == CFGState::LOOKUP_SWITCH);
+
+    state.lookupswitch.currentBlock++;
+
+    // Test if there are still unprocessed case bodies.
+    if (state.lookupswitch.currentBlock >= state.lookupswitch.numBodies)
+        return processLookupSwitchEnd(state);
+
+    MBasicBlock *successor = state.lookupswitch.bodies[state.lookupswitch.currentBlock];
+
+    // The previous case didn't end with a break, so it falls through into
+    // this one.
+    if (current) {
+        current->end(MGoto::New(successor));
+        successor->addPredecessor(current);
+
+        // Insert successor after the current block, to maintain RPO.
+        graph_.moveBlockToEnd(successor);
+    }
+
+    if (state.lookupswitch.currentBlock + 1 < state.lookupswitch.numBodies)
+        state.stopAt = state.lookupswitch.bodies[state.lookupswitch.currentBlock + 1]->pc();
+    else
+        state.stopAt = state.lookupswitch.exitpc;
+
+    current = successor;
+    pc = current->pc();
+    return ControlStatus_Jumped;
+}
+
+IonBuilder::ControlStatus
+IonBuilder::processLookupSwitchEnd(CFGState &state)
+{
+    // All cases ended with a return or throw.
+    if (!state.lookupswitch.breaks && !current)
+        return ControlStatus_Ended;
+
+    MBasicBlock *successor = NULL;
+    if (state.lookupswitch.breaks)
+        successor = createBreakCatchBlock(state.lookupswitch.breaks, state.lookupswitch.exitpc);
+    else
+        successor = newBlock(current, state.lookupswitch.exitpc);
+
+    if (!successor)
+        return ControlStatus_Ended;
+
+    if (current) {
+        current->end(MGoto::New(successor));
+        if (state.lookupswitch.breaks)
+            successor->addPredecessor(current);
+    }
+
+    pc = state.lookupswitch.exitpc;
+    current = successor;
+    return ControlStatus_Joined;
+}
+
 int
 IonBuilder::CmpSuccessors(const void *a, const void *b)
 {
@@ -1928,6 +1999,282 @@ IonBuilder::tableSwitch(JSOp op, jssrcnote *sn)
     return ControlStatus_Jumped;
 }
 
+int
+IonBuilder::CmpLookupSwitchCases(const void *a, const void *b)
+{
+    const LookupSwitchCase *a0 = (const LookupSwitchCase *)a;
+    const LookupSwitchCase *b0 = (const LookupSwitchCase *)b;
+    if (a0->key != b0->key)
+        return (a0->key > b0->key) ? 1 : -1;
+    if (a0->order != b0->order)
+        return (a0->order > b0->order) ? 1 : -1;
+    return 0;
+}
+
+int
+IonBuilder::CmpBytecodes(const void *a, const void *b)
+{
+    const jsbytecode *a0 = * (jsbytecode * const *)a;
+    const jsbytecode *b0 = * (jsbytecode * const *)b;
+    if (a0 == b0)
+        return 0;
+
+    return (a0 > b0) ? 1 : -1;
+}
+
+static size_t
+LookupSwitchBodyIndex(jsbytecode **bodyPcs, size_t numBodies, jsbytecode *pc)
+{
+    size_t low = 0, high = numBodies;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (bodyPcs[mid] < pc)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    JS_ASSERT(low < numBodies && bodyPcs[low] == pc);
+    return low;
+}
+
+IonBuilder::ControlStatus
+IonBuilder::lookupSwitch(JSOp op, jssrcnote *sn)
+{
+    // LookupSwitch op contains the following data
+    //
+    // 0: Offset of default case (JUMP_OFFSET_LEN)
+    // 1: Number of case pairs (UINT16_LEN)
+    // 2: Index of the constant of case 0 (UINT32_INDEX_LEN)
+    // 3: Offset of case 0 (JUMP_OFFSET_LEN)
+    // .: ...
+    //
+    // Cases are not ordered and may hold constants of any primitive type, so
+    // they are only compiled for int32 discriminants: the sorted int32 keys
+    // are dispatched with a balanced binary search of int32 compares, which
+    // cannot bail out.
+
+    JS_ASSERT(op == JSOP_LOOKUPSWITCH);
+
+    MDefinition *ins = current->pop();
+    if (ins->type() != MIRType_Int32) {
+        if (ins->type() != MIRType_Value || oracle->unaryOp(script, pc).ival != MIRType_Int32) {
+            abort("LOOKUPSWITCH with non-int32 discriminant");
+            return ControlStatus_Error;
+        }
+
+        MUnbox *unbox = MUnbox::New(ins, MIRType_Int32, MUnbox::Fallible);
+        current->add(unbox);
+        ins = unbox;
+    }
+
+    // Get the default and exit pc
+    jsbytecode *exitpc = pc + js_GetSrcNoteOffset(sn, 0);
+    jsbytecode *defaultpc = pc + GET_JUMP_OFFSET(pc);
+
+    JS_ASSERT(defaultpc > pc && defaultpc <= exitpc);
+
+    jsbytecode *pc2 = pc + JUMP_OFFSET_LEN;
+    uint32 npairs = GET_UINT16(pc2);
+    pc2 += UINT16_LEN;
+
+    Vector<LookupSwitchCase, 8, IonAllocPolicy> cases;
+    for (uint32 i = 0; i < npairs; i++) {
+        Value rval = script->getConst(GET_UINT32_INDEX(pc2));
+        pc2 += UINT32_INDEX_LEN;
+        jsbytecode *casepc = pc + GET_JUMP_OFFSET(pc2);
+        pc2 += JUMP_OFFSET_LEN;
+
+        JS_ASSERT(casepc > pc && casepc <= exitpc);
+
+        // Cases jumping to the default body need no test.
+        if (casepc == defaultpc)
+            continue;
+
+        // Only numbers with an int32 value are strictly equal to an int32.
+        int32_t key;
+        if (rval.isInt32()) {
+            key = rval.toInt32();
+        } else if (rval.isDouble() && MOZ_DOUBLE_IS_INT32(rval.toDouble(), &key)) {
+            // key is set.
+        } else if (rval.isDouble() && rval.toDouble() == 0) {
+            // -0 === 0.
+            key = 0;
+        } else {
+            continue;
+        }
+
+        LookupSwitchCase c;
+        c.key = key;
+        c.pc = casepc;
+        c.order = i;
+        if (!cases.append(c))
+            return ControlStatus_Error;
+    }
+
+    // Sort by key, and drop later duplicates: they can never be reached.
+    qsort(cases.begin(), cases.length(), sizeof(LookupSwitchCase), CmpLookupSwitchCases);
+    size_t numCases = 0;
+    for (size_t i = 0; i < cases.length(); i++) {
+        if (numCases && cases[numCases - 1].key == cases[i].key)
+            continue;
+        cases[numCases++] = cases[i];
+    }
+
+    // Collect the distinct case bodies, sorted by pc.
+    Vector<jsbytecode *, 8, IonAllocPolicy> pcs;
+    if (!pcs.append(defaultpc))
+        return ControlStatus_Error;
+    for (size_t i = 0; i < numCases; i++) {
+        if (!pcs.append(cases[i].pc))
+            return ControlStatus_Error;
+    }
+    qsort(pcs.begin(), pcs.length(), sizeof(jsbytecode *), CmpBytecodes);
+    size_t numBodies = 0;
+    for (size_t i = 0; i < pcs.length(); i++) {
+        if (numBodies && pcs[numBodies - 1] == pcs[i])
+            continue;
+        pcs[numBodies++] = pcs[i];
+    }
+
+    MBasicBlock **bodies = allocate<MBasicBlock *>(numBodies);
+    if (!bodies)
+        return ControlStatus_Error;
+    for (size_t i = 0; i < numBodies; i++)
+        bodies[i] = NULL;
+
+    // Build the dispatch, ending the current block.
+    if (!lookupSwitchDispatch(current, ins, cases.begin(), numCases,
+                              bodies, pcs.begin(), numBodies, defaultpc))
+    {
+        return ControlStatus_Error;
+    }
+
+    // Bodies were created while dispatch blocks were still being added; move
+    // them after the dispatch, in pc order, to maintain RPO.
+    for (size_t i = 0; i < numBodies; i++) {
+        JS_ASSERT(bodies[i]);
+        graph_.moveBlockToEnd(bodies[i]);
+    }
+
+    ControlFlowInfo switchinfo(cfgStack_.length(), exitpc);
+    if (!switches_.append(switchinfo))
+        return ControlStatus_Error;
+
+    CFGState state;
+    state.state = CFGState::LOOKUP_SWITCH;
+    state.lookupswitch.exitpc = exitpc;
+    state.lookupswitch.breaks = NULL;
+    state.lookupswitch.bodies = bodies;
+    state.lookupswitch.numBodies = numBodies;
+    state.lookupswitch.currentBlock = 0;
+
+    // If there is only one body the block should stop at the end of the
+    // switch, else it should stop at the start of the next body.
+    if (numBodies == 1)
+        state.stopAt = exitpc;
+    else
+        state.stopAt = bodies[1]->pc();
+    current = bodies[0];
+
+    if (!cfgStack_.append(state))
+        return ControlStatus_Error;
+
+    pc = current->pc();
+    return ControlStatus_Jumped;
+}
+
+MBasicBlock *
+IonBuilder::lookupSwitchBody(MBasicBlock **bodies, jsbytecode **bodyPcs, size_t numBodies,
+                             jsbytecode *bodyPc, MBasicBlock *pred)
+{
+    // Bodies are created when first reached from the dispatch, with that
+    // dispatch block as their first predecessor.
+    size_t index = LookupSwitchBodyIndex(bodyPcs, numBodies, bodyPc);
+    if (!bodies[index])
+        bodies[index] = newBlock(pred, bodyPc);
+    return bodies[index];
+}
+
+bool
+IonBuilder::linkLookupSwitchBody(MBasicBlock *body, MBasicBlock *pred)
+{
+    // The block that created |body| is already its predecessor.
+    if (body->getPredecessor(0) == pred)
+        return true;
+    return body->addPredecessor(pred);
+}
+
+bool
+IonBuilder::lookupSwitchDispatch(MBasicBlock *block, MDefinition *discriminant,
+                                 LookupSwitchCase *cases, size_t numCases,
+                                 MBasicBlock **bodies, jsbytecode **bodyPcs, size_t numBodies,
+                                 jsbytecode *defaultpc)
+{
+    // Dispatch blocks share the lookupswitch pc. They only hold int32
+    // compares and tests, so their entry resume points are never used to
+    // bail out.
+
+    // Small ranges are tested one key after the other.
+    static const size_t LINEAR_DISPATCH_LIMIT = 4;
+
+    if (numCases > LINEAR_DISPATCH_LIMIT) {
+        size_t mid = numCases / 2;
+
+        MBasicBlock *lower = newBlock(block, pc);
+        MBasicBlock *upper = newBlock(block, pc);
+        if (!lower || !upper)
+            return false;
+
+        MConstant *key = MConstant::New(Int32Value(cases[mid].key));
+        block->add(key);
+        MCompare *cmp = MCompare::NewInt32(discriminant, key, JSOP_LT);
+        block->add(cmp);
+        block->end(MTest::New(cmp, lower, upper));
+
+        return lookupSwitchDispatch(lower, discriminant, cases, mid,
+                                    bodies, bodyPcs, numBodies, defaultpc) &&
+               lookupSwitchDispatch(upper, discriminant, cases + mid, numCases - mid,
+                                    bodies, bodyPcs, numBodies, defaultpc);
+    }
+
+    if (numCases == 0) {
+        MBasicBlock *defaultBody = lookupSwitchBody(bodies, bodyPcs, numBodies, defaultpc, block);
+        if (!defaultBody)
+            return false;
+        block->end(MGoto::New(defaultBody));
+        return linkLookupSwitchBody(defaultBody, block);
+    }
+
+    for (size_t i = 0; i < numCases; i++) {
+        MBasicBlock *body = lookupSwitchBody(bodies, bodyPcs, numBodies, cases[i].pc, block);
+        if (!body)
+            return false;
+
+        // After the last key, control goes to the default body.
+        bool last = (i + 1 == numCases);
+        MBasicBlock *next = last
+                            ? lookupSwitchBody(bodies, bodyPcs, numBodies, defaultpc, block)
+                            : newBlock(block, pc);
+        if (!next)
+            return false;
+
+        MConstant *key = MConstant::New(Int32Value(cases[i].key));
+        block->add(key);
+        MCompare *cmp = MCompare::NewInt32(discriminant, key, JSOP_STRICTEQ);
+        block->add(cmp);
+        block->end(MTest::New(cmp, body, next));
+
+        if (!linkLookupSwitchBody(body, block))
+            return false;
+        if (last && !linkLookupSwitchBody(next, block))
+            return false;
+
+        block = next;
+    }
+
+    return true;
+}
+
 bool
 IonBuilder::jsop_andor(JSOp op)
 {
@@ -102,6 +102,7 @@ class IonBuilder : public MIRGenerator
             FOR_LOOP_BODY,      // for (; ;) { x }
             FOR_LOOP_UPDATE,    // for (; ; x) { }
             TABLE_SWITCH,       // switch() { x }
+            LOOKUP_SWITCH,      // switch() { x }, sparse cases
             AND_OR              // && x, || x
         };
 
@@ -152,6 +153,20 @@ class IonBuilder : public MIRGenerator
                 uint32 currentBlock;
 
             } tableswitch;
+            struct {
+                // pc immediately after the switch.
+                jsbytecode *exitpc;
+
+                // Deferred break and continue targets.
+                DeferredEdge *breaks;
+
+                // Case bodies (including the default case), sorted by pc.
+                MBasicBlock **bodies;
+                uint32 numBodies;
+
+                // The number of current successor that get mapped into a block.
+                uint32 currentBlock;
+            } lookupswitch;
         };
 
         inline bool isLoop() const {
@@ -174,7 +189,18 @@ class IonBuilder : public MIRGenerator
         static CFGState AndOr(jsbytecode *join, MBasicBlock *joinStart);
     };
 
+    // A case of a JSOP_LOOKUPSWITCH whose constant is an int32.
+    struct LookupSwitchCase {
+        int32 key;
+        jsbytecode *pc;
+
+        // Position in the bytecode, used to keep the first of duplicate keys.
+        uint32 order;
+    };
+
     static int CmpSuccessors(const void *a, const void *b);
+    static int CmpLookupSwitchCases(const void *a, const void *b);
+    static int CmpBytecodes(const void *a, const void *b);
 
   public:
     IonBuilder(JSContext *cx, HandleObject scopeChain, TempAllocator &temp, MIRGraph &graph,
@@ -216,6 +242,8 @@ class IonBuilder : public MIRGenerator
     ControlStatus processForUpdateEnd(CFGState &state);
     ControlStatus processNextTableSwitchCase(CFGState &state);
     ControlStatus processTableSwitchEnd(CFGState &state);
+    ControlStatus processNextLookupSwitchCase(CFGState &state);
+    ControlStatus processLookupSwitchEnd(CFGState &state);
     ControlStatus processAndOrEnd(CFGState &state);
     ControlStatus processSwitchBreak(JSOp op, jssrcnote *sn);
     ControlStatus processReturn(JSOp op);
@@ -258,6 +286,14 @@ class IonBuilder : public MIRGenerator
     ControlStatus whileOrForInLoop(JSOp op, jssrcnote *sn);
     ControlStatus doWhileLoop(JSOp op, jssrcnote *sn);
     ControlStatus tableSwitch(JSOp op, jssrcnote *sn);
+    ControlStatus lookupSwitch(JSOp op, jssrcnote *sn);
+    bool lookupSwitchDispatch(MBasicBlock *block, MDefinition *discriminant,
+                              LookupSwitchCase *cases, size_t numCases,
+                              MBasicBlock **bodies, jsbytecode **bodyPcs, size_t numBodies,
+                              jsbytecode *defaultpc);
+    MBasicBlock *lookupSwitchBody(MBasicBlock **bodies, jsbytecode **bodyPcs, size_t numBodies,
+                                  jsbytecode *bodyPc, MBasicBlock *pred);
+    bool linkLookupSwitchBody(MBasicBlock *body, MBasicBlock *pred);
 
     // Please see the Big Honkin' Comment about how resume points work in
     // IonBuilder.cpp, near the definition for this function.
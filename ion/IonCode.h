@@ -75,6 +75,7 @@ class IonCode : public gc::Cell
     uint32 dataSize_;               // Size of the read-only data area.
     uint32 jumpRelocTableBytes_;    // Size of the jump relocation table.
     uint32 dataRelocTableBytes_;    // Size of the data relocation table.
+    uint32 headerSize_;             // Bytes allocated before the buffer.
     JSBool invalidated_;            // Whether the code object has been invalidated.
                                     // This is necessary to prevent GC tracing.
 
@@ -82,7 +83,7 @@ class IonCode : public gc::Cell
       : code_(NULL),
         pool_(NULL)
     { }
-    IonCode(uint8 *code, uint32 bufferSize, JSC::ExecutablePool *pool)
+    IonCode(uint8 *code, uint32 headerSize, uint32 bufferSize, JSC::ExecutablePool *pool)
       : code_(code),
         pool_(pool),
         bufferSize_(bufferSize),
@@ -90,6 +91,7 @@ class IonCode : public gc::Cell
         dataSize_(0),
         jumpRelocTableBytes_(0),
         dataRelocTableBytes_(0),
+        headerSize_(headerSize),
         invalidated_(false)
     { }
 
@@ -149,7 +151,8 @@ class IonCode : public gc::Cell
     // Allocates a new IonCode object which will be managed by the GC. If no
     // object can be allocated, NULL is returned. On failure, |pool| is
     // automatically released, so the code may be freed.
-    static IonCode *New(JSContext *cx, uint8 *code, uint32 bufferSize, JSC::ExecutablePool *pool);
+    static IonCode *New(JSContext *cx, uint8 *code, uint32 headerSize, uint32 bufferSize,
+                        JSC::ExecutablePool *pool);
 
   public:
     static void readBarrier(IonCode *code);
@@ -192,6 +195,9 @@ struct IonScript
     // Useful when a bailout is expected.
     bool forbidOsr_;
 
+    // Number of OSR attempts at a loop entry other than |osrPc_|.
+    uint32 osrPcMismatchCounter_;
+
     // Offset from the start of the code buffer to its snapshot buffer.
     uint32 snapshots_;
     uint32 snapshotsSize_;
@@ -319,6 +325,12 @@ struct IonScript
     bool isOsrForbidden() const {
         return forbidOsr_;
     }
+    uint32 incrOsrPcMismatchCounter() {
+        return ++osrPcMismatchCounter_;
+    }
+    void resetOsrPcMismatchCounter() {
+        osrPcMismatchCounter_ = 0;
+    }
     const uint8 *snapshots() const {
         return reinterpret_cast<const uint8 *>(this) + snapshots_;
     }
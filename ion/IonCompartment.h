@@ -89,6 +89,9 @@ class IonCompartment
     // Map VMFunction addresses to the IonCode of the wrapper.
     VMWrapperMap *functionWrappers_;
 
+    // Number of scripts recompiled to move their OSR entry to another loop.
+    uint32 osrRecompiles_;
+
   private:
     IonCode *generateEnterJIT(JSContext *cx);
     IonCode *generateReturnError(JSContext *cx);
@@ -167,6 +170,13 @@ class IonCompartment
         }
         return preBarrier_;
     }
+
+    void noteOsrRecompile() {
+        osrRecompiles_++;
+    }
+    uint32 osrRecompiles() const {
+        return osrRecompiles_;
+    }
 };
 
 class BailoutClosure;
@@ -72,6 +72,10 @@ class Linker
         if (bytesNeeded >= MAX_BUFFER_SIZE)
             return fail(cx);
 
+        // Round up as the allocator does, so the IonCode knows exactly how
+        // many bytes it gives back to the pool.
+        bytesNeeded = AlignBytes(bytesNeeded, sizeof(void *));
+
         uint8 *result = (uint8 *)comp->execAlloc()->alloc(bytesNeeded, &pool, JSC::METHOD_CODE);
         if (!result)
             return fail(cx);
@@ -82,7 +86,7 @@ class Linker
         // Bump the code up to a nice alignment.
         codeStart = (uint8 *)AlignBytes((uintptr_t)codeStart, CodeAlignment);
         uint32 headerSize = codeStart - result;
-        IonCode *code = IonCode::New(cx, codeStart,
+        IonCode *code = IonCode::New(cx, codeStart, headerSize,
                                      bytesNeeded - headerSize, pool);
         if (!code)
             return NULL;
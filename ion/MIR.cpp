@@ -404,6 +404,14 @@ MCompare::New(MDefinition *left, MDefinition *right, JSOp op)
     return new MCompare(left, right, op);
 }
 
+MCompare *
+MCompare::NewInt32(MDefinition *left, MDefinition *right, JSOp op)
+{
+    MCompare *ins = new MCompare(left, right, op);
+    ins->specialization_ = MIRType_Int32;
+    return ins;
+}
+
 MTableSwitch *
 MTableSwitch::New(MDefinition *ins, int32 low, int32 high)
 {
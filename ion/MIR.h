@@ -1329,6 +1329,9 @@ class MCompare
     INSTRUCTION_HEADER(Compare);
     static MCompare *New(MDefinition *left, MDefinition *right, JSOp op);
 
+    // Compare two operands known to be int32, without consulting the oracle.
+    static MCompare *NewInt32(MDefinition *left, MDefinition *right, JSOp op);
+
     void infer(JSContext *cx, const TypeOracle::BinaryTypes &b);
     MIRType specialization() const {
         return specialization_;
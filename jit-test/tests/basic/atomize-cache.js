@@ -0,0 +1,44 @@
+// Atomizing the same chars repeatedly must yield the same property, across
+// GCs and when many names collide in the atomize cache.
+
+var names = [];
+for (var i = 0; i < 1000; i++)
+    names.push("p" + i + "_" + String.fromCharCode(0x100 + i % 64));
+
+var o = {};
+for (var round = 0; round < 3; round++) {
+    for (var i = 0; i < names.length; i++)
+        o[names[i]] = (o[names[i]] | 0) + 1;
+    gc();
+}
+for (var i = 0; i < names.length; i++)
+    assertEq(o[names[i]], 3);
+
+var parsed = JSON.parse('[{"alpha":1,"":2},{"alpha":3,"":4}]');
+assertEq(parsed[1].alpha, 3);
+assertEq(parsed[1][""], 4);
+assertEq(Object.keys(o).length, names.length);
+
+// An atom handed out by the cache during incremental marking must be marked,
+// or the sweep at the end of the GC would free it while it is still in use.
+if (typeof gcslice === "function") {
+    var kept = [];
+    for (var round = 0; round < 20; round++) {
+        var name = "tmp" + round + "_" + String.fromCharCode(0x200 + round);
+        var t = {};
+        t[name] = round;          // atomize and cache a temporary name
+        t = null;
+        gcslice(1);               // start or continue incremental marking
+        var h = {};
+        h[name] = round;          // cache hit while marking is in progress
+        kept.push(h);
+        gcslice(1000000);         // finish the GC, sweeping the atoms table
+    }
+    gc();
+    for (var round = 0; round < kept.length; round++) {
+        var keys = Object.keys(kept[round]);
+        assertEq(keys.length, 1);
+        assertEq(keys[0], "tmp" + round + "_" + String.fromCharCode(0x200 + round));
+        assertEq(kept[round][keys[0]], round);
+    }
+}
@@ -0,0 +1,32 @@
+// Array.prototype.concat copies dense array arguments in bulk.
+
+var a = [1, 2, 3];
+var b = [4, , 6];
+var c = ["x", {}, 7.5];
+var r = a.concat(b, c, 8, [[9]]);
+assertEq(r.length, 10);
+assertEq(r.join(), "1,2,3,4,,6,x,[object Object],7.5,8,9");
+assertEq(4 in r, false);
+assertEq(5 in r, true);
+assertEq(r[9][0], 9);
+
+// Arrays whose length exceeds their initialized elements.
+var sparse = [1, 2];
+sparse.length = 5;
+var r2 = [0].concat(sparse, [3]);
+assertEq(r2.length, 7);
+assertEq(r2[6], 3);
+assertEq(3 in r2, false);
+
+// Holes still see indexed properties on the prototype.
+Array.prototype[1] = "proto";
+var r3 = [].concat([0, , 2]);
+assertEq(r3[1], "proto");
+assertEq(r3.hasOwnProperty(1), true);
+delete Array.prototype[1];
+
+// Mutating the result leaves the sources untouched.
+var src = [1, 2, 3];
+var copy = [].concat(src);
+copy[0] = 100;
+assertEq(src[0], 1);
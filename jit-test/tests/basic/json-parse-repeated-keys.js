@@ -0,0 +1,84 @@
+// JSON.parse caches property name atoms and sizes objects after their
+// siblings; results must not depend on either.
+
+var records = [];
+for (var i = 0; i < 200; i++)
+    records.push('{"id":' + i + ',"name":"n' + i + '","k' + (i % 7) + '":true,"0":' + i + '}');
+var parsed = JSON.parse('[' + records.join(',') + ']');
+
+assertEq(parsed.length, 200);
+for (var i = 0; i < parsed.length; i++) {
+    var r = parsed[i];
+    assertEq(r.id, i);
+    assertEq(r.name, "n" + i);
+    assertEq(r["k" + (i % 7)], true);
+    assertEq(r[0], i);
+    assertEq(Object.keys(r).sort().join(), "0,id,k" + (i % 7) + ",name");
+}
+
+// Keys that differ only in length or in escapes.
+var o = JSON.parse('{"a":1,"aa":2,"a\\u0061":3,"":4,"\\"":5}');
+assertEq(o.a, 1);
+assertEq(o.aa, 3);
+assertEq(o[""], 4);
+assertEq(o['"'], 5);
+
+// Objects much larger or smaller than their siblings.
+var big = {};
+for (var i = 0; i < 40; i++)
+    big["p" + i] = i;
+var list = JSON.parse('[' + JSON.stringify(big) + ',{},{"x":1},' + JSON.stringify(big) + ']');
+assertEq(Object.keys(list[0]).length, 40);
+assertEq(Object.keys(list[1]).length, 0);
+assertEq(list[2].x, 1);
+assertEq(list[3].p39, 39);
+
+// Index-like keys of 256 and up become int ids, so nothing but the parser's
+// key cache would hold their atoms. They must survive GCs during the parse.
+function indexRecords(n) {
+    var recs = [];
+    for (var i = 0; i < n; i++)
+        recs.push('{"1000":' + i + ',"65536":' + i + ',"k":' + i + '}');
+    return '[' + recs.join(',') + ']';
+}
+function checkIndexRecords(a, n) {
+    assertEq(a.length, n);
+    for (var i = 0; i < n; i++) {
+        assertEq(a[i][1000], i);
+        assertEq(a[i][65536], i);
+        assertEq(a[i].k, i);
+    }
+}
+
+var revived = 0;
+var text = indexRecords(50);
+var withReviver = JSON.parse(text, function (k, v) {
+    if (++revived % 10 == 0)
+        gc();
+    return v;
+});
+checkIndexRecords(withReviver, 50);
+
+if (typeof gczeal === "function") {
+    gczeal(2, 5);
+    checkIndexRecords(JSON.parse(indexRecords(100)), 100);
+    gczeal(0);
+}
+if (typeof gcslice === "function") {
+    gcslice(1);
+    checkIndexRecords(JSON.parse(indexRecords(100)), 100);
+    gc();
+}
+
+// Records whose members are objects of a different size than the records.
+var nested = [];
+for (var i = 0; i < 20; i++)
+    nested.push('{"a":1,"b":2,"c":3,"d":4,"e":5,"f":6,"g":7,"h":8,"in":{"x":' + i + '}}');
+var outer = JSON.parse('[' + nested.join(',') + ']');
+assertEq(outer.length, 20);
+for (var i = 0; i < outer.length; i++) {
+    assertEq(Object.keys(outer[i]).length, 9);
+    assertEq(outer[i].h, 8);
+    assertEq(Object.keys(outer[i].in).join(), "x");
+    assertEq(outer[i].in.x, i);
+}
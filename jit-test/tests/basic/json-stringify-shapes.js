@@ -0,0 +1,38 @@
+// JSON.stringify reuses the property list of objects sharing a shape.
+
+var rows = [];
+for (var i = 0; i < 50; i++)
+    rows.push({ id: i, "quote\"d": "\n" + i, 7: i * 0.5 });
+var actual = JSON.parse(JSON.stringify(rows));
+assertEq(actual.length, 50);
+for (var i = 0; i < 50; i++) {
+    assertEq(Object.keys(actual[i]).length, 3);
+    assertEq(actual[i].id, i);
+    assertEq(actual[i]["quote\"d"], "\n" + i);
+    assertEq(actual[i][7], i * 0.5);
+}
+assertEq(JSON.stringify(rows).indexOf('"quote\\"d":"\\n3"') > 0, true);
+
+// Non-enumerable properties are still skipped.
+var a = { x: 1, y: 2 };
+var b = { x: 3, y: 4 };
+Object.defineProperty(b, "z", { value: 5, enumerable: false });
+assertEq(JSON.stringify([a, b]), '[{"x":1,"y":2},{"x":3,"y":4}]');
+
+// Properties deleted by toJSON are skipped, values changed by it are seen.
+var c = { x: { toJSON: function () { delete c.y; c.z = 9; return 1; } }, y: 2, z: 3 };
+var d = { x: 5, y: 6, z: 7 };
+assertEq(JSON.stringify([d, c, d]), '[{"x":5,"y":6,"z":7},{"x":1,"z":9},{"x":5,"y":6,"z":7}]');
+
+// Objects without a prototype hide __proto__ only when they have none.
+var n = Object.create(null);
+n.k = 1;
+assertEq(JSON.stringify(n), '{"k":1}');
+
+// Collections in the middle of stringifying must not confuse the cache.
+var withGC = [];
+for (var i = 0; i < 20; i++)
+    withGC.push({ p: i, q: { toJSON: function () { gc(); return { r: 1 }; } } });
+var s = JSON.stringify(withGC);
+assertEq(JSON.parse(s)[19].p, 19);
+assertEq(JSON.parse(s)[19].q.r, 1);
@@ -0,0 +1,30 @@
+// propertyCacheStats() counts real hits once a monomorphic site is warm.
+// The counters are only compiled into debug builds.
+if (typeof propertyCacheStats !== "function")
+    quit();
+
+var before = propertyCacheStats();
+assertEq(typeof before.hits, "number");
+assertEq(typeof before.misses, "number");
+assertEq(typeof before.evictions, "number");
+
+// The 'with' keeps the JITs from compiling sum(), so its property accesses
+// go through the interpreter's property cache.
+function sum(o, n) {
+    with ({}) {}
+    var s = 0;
+    for (var i = 0; i < n; i++)
+        s += o.x;
+    return s;
+}
+
+var o = {x: 2};
+assertEq(sum(o, 10), 20);                 // warm the o.x site
+
+var warm = propertyCacheStats();
+assertEq(sum(o, 1000), 2000);
+var after = propertyCacheStats();
+
+// Each of the 1000 o.x lookups hits the same (pc, shape) entry.
+assertEq(after.hits - warm.hits >= 1000, true);
+assertEq(after.misses - warm.misses < 10, true);
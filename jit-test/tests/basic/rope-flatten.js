@@ -0,0 +1,70 @@
+// Flattening copies each leaf of a rope into one buffer. Check the contents
+// of deep ropes, balanced ropes and ropes whose leaves are dependent strings,
+// with leaves shorter and longer than 128 characters.
+
+function leaf(n, seed) {
+    var chars = [];
+    for (var i = 0; i < n; i++)
+        chars.push(String.fromCharCode(i % 5 == 0 ? 0x20ac + seed % 7 : 0x41 + (seed + i) % 26));
+    return chars.join("");
+}
+
+function check(rope, parts) {
+    var expected = parts.join("");
+    assertEq(rope.length, expected.length);
+    assertEq(rope, expected);
+    var pos = 0;
+    for (var i = 0; i < parts.length; i++) {
+        if (parts[i].length) {
+            assertEq(rope.charCodeAt(pos), parts[i].charCodeAt(0));
+            assertEq(rope.charCodeAt(pos + parts[i].length - 1),
+                     parts[i].charCodeAt(parts[i].length - 1));
+        }
+        pos += parts[i].length;
+    }
+}
+
+// Left-deep and right-deep ropes.
+var parts = [];
+var left = "", right = "";
+for (var i = 0; i < 1000; i++) {
+    var p = leaf(i % 300, i);
+    parts.push(p);
+    left = left + p;
+    right = p + right;
+}
+check(left, parts);
+check(right, parts.slice().reverse());
+
+// A balanced rope.
+function balanced(parts, begin, end) {
+    if (end - begin == 1)
+        return parts[begin];
+    var mid = (begin + end) >> 1;
+    return balanced(parts, begin, mid) + balanced(parts, mid, end);
+}
+check(balanced(parts, 0, parts.length), parts);
+
+// Leaves that are dependent strings of a larger string.
+var base = leaf(5000, 3);
+var deps = [];
+var rope = "";
+for (var i = 0; i < 500; i++) {
+    var start = (i * 37) % 4000;
+    var d = base.substring(start, start + 1 + (i * 13) % 400);
+    deps.push(d);
+    rope = rope + d;
+}
+check(rope, deps);
+
+// Appending to a flattened rope reuses its buffer; check the copy again.
+var grown = left;
+var grownParts = parts.slice();
+for (var i = 0; i < 200; i++) {
+    var p = deps[i];
+    grownParts.push(p);
+    grown = grown + p;
+    if (i % 50 == 0)
+        check(grown, grownParts);
+}
+check(grown, grownParts);
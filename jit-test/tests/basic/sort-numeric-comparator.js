@@ -0,0 +1,35 @@
+// Array.prototype.sort recognizes (a, b) => a - b style comparators.
+
+function check(arr, cmp, expected) {
+    arr.sort(cmp);
+    assertEq(arr.length, expected.length);
+    for (var i = 0; i < arr.length; i++)
+        assertEq(arr[i], expected[i]);
+}
+
+check([3, 1, 2, 10, -5], function (a, b) { return a - b; }, [-5, 1, 2, 3, 10]);
+check([3, 1, 2, 10, -5], function (a, b) { return b - a; }, [10, 3, 2, 1, -5]);
+check([1.5, -0.5, Infinity, -Infinity, 2], function (a, b) { return a - b; },
+      [-Infinity, -0.5, 1.5, 2, Infinity]);
+
+// Holes and undefined still go to the end.
+check([3, undefined, 1, , 2], function (a, b) { return a - b; }, [1, 2, 3, undefined, undefined]);
+
+// The sort stays stable for -0 and +0.
+var zeros = [0, -0, 0, -0].sort(function (a, b) { return a - b; });
+assertEq(1 / zeros[0], Infinity);
+assertEq(1 / zeros[1], -Infinity);
+assertEq(1 / zeros[2], Infinity);
+assertEq(1 / zeros[3], -Infinity);
+
+// Non-number elements must still see valueOf being called.
+var calls = 0;
+var obj = { valueOf: function () { calls++; return 5; } };
+check([7, obj, 3], function (a, b) { return a - b; }, [3, obj, 7]);
+assertEq(calls > 0, true);
+
+// Comparators that only look similar are invoked normally.
+var invoked = 0;
+check([3, 1, 2], function (a, b) { invoked++; return a - b; }, [1, 2, 3]);
+assertEq(invoked > 0, true);
+check([3, 1, 2], function (a, b, c) { return a - c; }, [3, 1, 2]);
@@ -0,0 +1,43 @@
+// String search and comparison at every offset around the 8-char vector width.
+
+function naiveIndexOf(text, pat) {
+    for (var i = 0; i + pat.length <= text.length; i++) {
+        if (text.substr(i, pat.length) === pat)
+            return i;
+    }
+    return -1;
+}
+
+var base = "abcdefghijklmnopqrstuvwxyz0123456789";
+for (var len = 0; len < 40; len++) {
+    var text = base.substr(0, len);
+    for (var plen = 1; plen < 12; plen++) {
+        for (var start = 0; start + plen <= len; start++) {
+            var pat = text.substr(start, plen);
+            assertEq(text.indexOf(pat), naiveIndexOf(text, pat));
+        }
+        assertEq(text.indexOf("#".substr(0, 1) + "x".substr(0, plen - 1)), -1);
+    }
+}
+
+// Non-Latin-1 characters and repeated candidates.
+var wide = "\u1234aa\u1234ab\u1234abc\u1234abcd\u1234abcde\u1234";
+assertEq(wide.indexOf("\u1234abcde"), 15);
+assertEq(wide.indexOf("\u1234abcdef"), -1);
+assertEq(wide.indexOf("b\u1234"), 5);
+assertEq("aaaaaaaaaaaaaaaaaaab".indexOf("aab"), 17);
+assertEq("x,y,,z".split(",").join("|"), "x|y||z");
+assertEq("a--b--c".split("--").length, 3);
+assertEq("$1-$2".replace(/(\d)?/, "$$"), "$$1-$2");
+
+// Equality and ordering differing at every position.
+var s1 = "0123456789abcdefghij";
+for (var i = 0; i < s1.length; i++) {
+    var s2 = s1.substr(0, i) + "~" + s1.substr(i + 1);
+    assertEq(s1 == s2, false);
+    assertEq(s1 < s2, true);
+    assertEq(s2 > s1, true);
+    assertEq(s1 == (s1.substr(0, i) + s1.substr(i)), true);
+}
+assertEq("abcdefghij" < "abcdefghijk", true);
+assertEq("abcdefghijk" < "abcdefghij", false);
@@ -0,0 +1,26 @@
+// gcstats() reports the most recent GC as JSON.
+
+// Each object gets its own property name, so the garbage includes many
+// shapes as well as the objects themselves.
+var garbage = [];
+for (var i = 0; i < 20000; i++) {
+    var o = {};
+    o["gcstats" + i] = i;
+    garbage.push(o);
+}
+gc();
+garbage = null;
+gc();
+
+// Objects may be finalized on the helper thread after gc() returns, and the
+// heap size after the GC is only reported once that is done. Tracing the heap
+// waits for the helper thread.
+countHeap();
+
+var stats = JSON.parse(gcstats());
+assertEq(typeof stats.timestamp, "number");
+assertEq(typeof stats.total_time, "number");
+assertEq(stats.bytes_before - stats.bytes_after >= 256 * 1024, true);
+assertEq(stats.slices.length >= 1, true);
+assertEq(typeof stats.slices[0].reason, "string");
+assertEq(typeof stats.totals.mark, "number");
@@ -0,0 +1,28 @@
+// Back-to-back GCs switch to a larger heap growth factor without changing
+// what is collected.
+
+assertEq(gcparam("highFrequencyTimeLimit"), 1000);
+
+// With a zero limit no GC counts as high frequency.
+gcparam("highFrequencyTimeLimit", 0);
+gc();
+gc();
+var normalTrigger = gcTriggerBytes();
+
+gcparam("highFrequencyTimeLimit", 60 * 1000);
+assertEq(gcparam("highFrequencyTimeLimit"), 60000);
+
+var live = [];
+for (var n = 0; n < 5; n++) {
+    for (var i = 0; i < 20000; i++) {
+        var o = { n: n, i: i };
+        if (i % 100 == 0)
+            live.push(o);
+    }
+    gc();
+}
+assertEq(live.length, 1000);
+assertEq(live[999].n, 4);
+assertEq(gcTriggerBytes() > normalTrigger, true);
+
+gcparam("highFrequencyTimeLimit", 1000);
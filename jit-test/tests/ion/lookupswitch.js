@@ -0,0 +1,39 @@
+// Test sparse int32 switches (JSOP_LOOKUPSWITCH) for IonMonkey.
+
+function sparse(x) {
+    var r = 0;
+    switch (x) {
+      case -1000: r = 1; break;
+      case 3: r = 2; break;
+      case 7: r = 3;
+      case 100: r += 4; break;
+      case 5000: r = 5; break;
+      case 5000: r = 6; break;
+      case 65536: return 7;
+      case 1 << 30: r = 8; break;
+      case -0: r = 9; break;
+      case "3": r = 10; break;
+      default: r = 11; break;
+    }
+    return r;
+}
+
+function sparseNoDefault(x) {
+    var r = 0;
+    switch (x) {
+      case 10: r = 1; break;
+      case 1000: r = 2; break;
+      case 100000: r = 3; break;
+    }
+    return r;
+}
+
+var inputs = [-1000, 3, 7, 100, 5000, 65536, 1 << 30, 0, 1, 4, -1, 99999];
+var expected = [1, 2, 7, 4, 5, 7, 8, 9, 11, 11, 11, 11];
+
+for (var i = 0; i < 100; i++) {
+    for (var j = 0; j < inputs.length; j++) {
+        assertEq(sparse(inputs[j]), expected[j]);
+        assertEq(sparseNoDefault(inputs[j] * 10), [10, 1000, 100000].indexOf(inputs[j] * 10) + 1);
+    }
+}
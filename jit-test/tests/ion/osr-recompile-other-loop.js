@@ -0,0 +1,55 @@
+// A script compiled for OSR at one loop must still be able to enter Ion code
+// from a second, hotter loop.
+
+// Keep JaegerMonkey from taking over the interpreted frames below, so the
+// OSR attempts all go to IonMonkey.
+if (options().split(",").indexOf("methodjit") != -1)
+    options("methodjit");
+
+function f(n, m, nested) {
+    var a = 0;
+    for (var i = 0; i < n; i++)
+        a += i;
+    var b = 0;
+    for (var j = 0; j < m; j++) {
+        b += j & 3;
+        // The nested call OSRs into the first loop while this frame is still
+        // interpreting the second one.
+        if (nested && j == 10)
+            b += f(100, 0, false) - 4950;
+    }
+    return a + b;
+}
+
+var before = ionOsrRecompiles();
+assertEq(f(0, 20000, true), 30000);
+assertEq(f(10, 5000, false), 45 + 7500);
+if (before !== undefined)
+    assertEq(ionOsrRecompiles() - before, 1);
+
+// Code compiled for function entry has no OSR entry; a frame that began
+// interpreting before that compile must not throw it away. The nested calls
+// return before reaching a loop, so g is compiled at its entry.
+function callMany(fn, n) {
+    var r = 0;
+    for (var k = 0; k < n; k++)
+        r += fn(0);
+    return r;
+}
+
+function g(m) {
+    if (m == 0)
+        return 0;
+    var b = 0;
+    for (var j = 0; j < m; j++) {
+        b += j & 3;
+        if (j == 5)
+            b += callMany(g, 100);
+    }
+    return b;
+}
+
+before = ionOsrRecompiles();
+assertEq(g(20000), 30000);
+if (before !== undefined)
+    assertEq(ionOsrRecompiles(), before);
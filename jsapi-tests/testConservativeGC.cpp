@@ -1,4 +1,6 @@
 #include "tests.h"
+#include "jscntxt.h"
+#include "jsgc.h"
 #include "jsobj.h"
 #include "vm/String.h"
 
@@ -76,3 +78,74 @@ BEGIN_TEST(testDerivedValues)
   return true;
 }
 END_TEST(testDerivedValues)
+
+static unsigned finalizeCount;
+static uintptr_t rootedAddress;
+static bool rootedFinalized;
+
+static void
+CountingFinalize(JSFreeOp *fop, JSObject *obj)
+{
+    finalizeCount++;
+    if (uintptr_t(obj) == rootedAddress)
+        rootedFinalized = true;
+}
+
+static JSClass CountingClass = {
+    "Counting", 0,
+    JS_PropertyStub,       /* addProperty */
+    JS_PropertyStub,       /* delProperty */
+    JS_PropertyStub,       /* getProperty */
+    JS_StrictPropertyStub, /* setProperty */
+    JS_EnumerateStub,
+    JS_ResolveStub,
+    JS_ConvertStub,
+    CountingFinalize
+};
+
+BEGIN_TEST(testConservativeGC_chunkRange)
+{
+    JSObject *obj = JS_NewObject(cx, &CountingClass, NULL, NULL);
+    CHECK(obj);
+    rootedAddress = uintptr_t(obj);
+    rootedFinalized = false;
+    CHECK(rt->gcChunkAddressMin <= rootedAddress);
+    CHECK(rootedAddress < rt->gcChunkAddressLimit);
+
+    /*
+     * Words the scanner must reject, before or after the chunk range check,
+     * next to the only reference to a live object.
+     */
+    js::gc::Chunk *chunk = js::gc::Chunk::fromAddress(rootedAddress);
+    volatile uintptr_t words[] = {
+        0,
+        1,
+        rt->gcChunkAddressMin - sizeof(void *),
+        rt->gcChunkAddressLimit,
+        uintptr_t(-1) - (sizeof(void *) - 1),
+        uintptr_t(&chunk->info),
+        rootedAddress
+    };
+    obj = NULL;
+
+    /* Garbage of the same class, referenced by nothing. */
+    const unsigned garbageCount = 100;
+    for (unsigned i = 0; i != garbageCount; i++)
+        CHECK(JS_NewObject(cx, &CountingClass, NULL, NULL));
+
+    finalizeCount = 0;
+    JS_GC(rt);
+#ifdef JS_THREADSAFE
+    {
+        js::AutoLockGC lock(rt);
+        rt->gcHelperThread.waitBackgroundSweepEnd();
+    }
+#endif
+
+    /* Stale stack words may keep a few of the garbage objects alive. */
+    CHECK(!rootedFinalized);
+    CHECK(finalizeCount >= garbageCount - 10);
+    CHECK(words[mozilla::ArrayLength(words) - 1] == rootedAddress);
+    return true;
+}
+END_TEST(testConservativeGC_chunkRange)
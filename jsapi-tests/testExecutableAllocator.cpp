@@ -0,0 +1,60 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ * vim: set ts=8 sw=4 et tw=99:
+ */
+
+#include "tests.h"
+
+#include "assembler/jit/ExecutableAllocator.h"
+
+#if ENABLE_ASSEMBLER
+
+BEGIN_TEST(testExecutableAllocator_cachedPages)
+{
+    JSC::ExecutableAllocator execAlloc(JSC::AllocationDeterministic);
+    size_t method, regexp, unused;
+
+    /* The first pool's size tells us how big a small pool is. */
+    JSC::ExecutablePool *pools[5];
+    CHECK(execAlloc.alloc(sizeof(void *), &pools[0], JSC::METHOD_CODE));
+    execAlloc.sizeOfCode(&method, &regexp, &unused);
+    size_t poolSize = method + unused;
+
+    /*
+     * Fill the allocator's small pools with full ones, so that the last pool
+     * is held by nobody but us and is destroyed when we release it.
+     */
+    char *code = NULL;
+    for (size_t i = 1; i < 5; i++) {
+        code = (char *) execAlloc.alloc(poolSize, &pools[i], JSC::METHOD_CODE);
+        CHECK(code);
+    }
+    JSC::ExecutableAllocator::makeWritable(code, poolSize);
+    memset(code, 0xAB, poolSize);
+    JSC::ExecutableAllocator::makeExecutable(code, poolSize);
+
+    execAlloc.sizeOfCode(&method, &regexp, &unused);
+    size_t methodBefore = method, unusedBefore = unused;
+
+    /* The released pages stay mapped and are reported as unused. */
+    pools[4]->release(poolSize, JSC::METHOD_CODE);
+    execAlloc.sizeOfCode(&method, &regexp, &unused);
+    CHECK_EQUAL(method, methodBefore - poolSize);
+    CHECK_EQUAL(unused, unusedBefore + poolSize);
+
+    /* A new pool reuses them, without the code that was left there. */
+    char *reused = (char *) execAlloc.alloc(poolSize, &pools[4], JSC::METHOD_CODE);
+    CHECK(reused == code);
+    for (size_t i = 0; i < poolSize; i++)
+        CHECK_EQUAL(reused[i], 0);
+    execAlloc.sizeOfCode(&method, &regexp, &unused);
+    CHECK_EQUAL(method, methodBefore);
+    CHECK_EQUAL(unused, unusedBefore);
+
+    pools[0]->release(sizeof(void *), JSC::METHOD_CODE);
+    for (size_t i = 1; i < 5; i++)
+        pools[i]->release(poolSize, JSC::METHOD_CODE);
+    return true;
+}
+END_TEST(testExecutableAllocator_cachedPages)
+
+#endif /* ENABLE_ASSEMBLER */
@@ -0,0 +1,48 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ * vim: set ts=8 sw=4 et tw=99:
+ */
+
+#include "tests.h"
+#include "jscntxt.h"
+#include "jsgc.h"
+
+BEGIN_TEST(testGCChunkList_sortedByFreeArenas)
+{
+    /*
+     * Fill several chunks with objects, then keep runs of them alive at a
+     * different density in each chunk's worth of the heap, so that the
+     * available chunks end up with different numbers of free arenas.
+     */
+    EXEC("var live = [];\n"
+         "(function () {\n"
+         "    var all = [];\n"
+         "    for (var i = 0; i < 100000; i++)\n"
+         "        all.push({});\n"
+         "    for (var i = 0; i < all.length; i++) {\n"
+         "        var keepEvery = 2 + (i >> 14) % 6;\n"
+         "        if ((i >> 8) % keepEvery == 0)\n"
+         "            live.push(all[i]);\n"
+         "    }\n"
+         "})();\n");
+    JS_GC(rt);
+
+#ifdef JS_THREADSAFE
+    /* The list is sorted after the helper thread has finished sweeping. */
+    {
+        js::AutoLockGC lock(rt);
+        rt->gcHelperThread.waitBackgroundSweepEnd();
+    }
+#endif
+
+    /* The chunks with the fewest free arenas come first. */
+    size_t count = 0;
+    uint32_t lastFree = 0;
+    for (js::gc::Chunk *chunk = rt->gcUserAvailableChunkListHead; chunk; chunk = chunk->info.next) {
+        CHECK(chunk->info.numArenasFree >= lastFree);
+        lastFree = chunk->info.numArenasFree;
+        count++;
+    }
+    CHECK(count >= 2);
+    return true;
+}
+END_TEST(testGCChunkList_sortedByFreeArenas)
@@ -0,0 +1,54 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ * vim: set ts=8 sw=4 et tw=99:
+ */
+
+#include "tests.h"
+#include "jscntxt.h"
+#include "jsgc.h"
+
+BEGIN_TEST(testGCChunkPool_expiry)
+{
+    /* Fill a few chunks with garbage, so that the GC returns them to the pool. */
+    CHECK(makeGarbage());
+    collect();
+    size_t emptyCount = rt->gcChunkPool.getEmptyCount();
+    CHECK(emptyCount > 0);
+
+    /*
+     * While every cycle takes chunks from the pool again, they stay pooled
+     * for longer than the age at which unused empty chunks are released.
+     */
+    for (size_t i = 0; i <= js::gc::MAX_EMPTY_CHUNK_AGE + 1; i++) {
+        CHECK(makeGarbage());
+        collect();
+        CHECK(rt->gcChunkPool.getEmptyCount() > 0);
+    }
+
+    /* Once nothing takes chunks from the pool, they are released as they age. */
+    for (size_t i = 0; i <= js::gc::MAX_EMPTY_CHUNK_AGE + 1; i++)
+        collect();
+    CHECK_EQUAL(rt->gcChunkPool.getEmptyCount(), size_t(0));
+    return true;
+}
+
+bool makeGarbage()
+{
+    EXEC("(function () {\n"
+         "    var garbage = [];\n"
+         "    for (var i = 0; i < 50000; i++)\n"
+         "        garbage.push({});\n"
+         "})();\n");
+    return true;
+}
+
+void collect()
+{
+    JS_GC(rt);
+
+#ifdef JS_THREADSAFE
+    /* Chunks are expired on the helper thread once it has finished sweeping. */
+    js::AutoLockGC lock(rt);
+    rt->gcHelperThread.waitBackgroundSweepEnd();
+#endif
+}
+END_TEST(testGCChunkPool_expiry)
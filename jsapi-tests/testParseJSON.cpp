@@ -234,3 +234,101 @@ TryParse(JSContext *cx, const char (&input)[N], jsval filter)
     return true;
 }
 END_TEST(testParseJSON_reviver)
+
+static unsigned errorCount;
+
+struct StreamElements {
+    unsigned count;
+    jsval last;
+};
+
+static JSBool
+CountElement(JSContext *cx, jsval v, void *data)
+{
+    StreamElements *elements = static_cast<StreamElements *>(data);
+    elements->count++;
+    elements->last = v;
+    return true;
+}
+
+BEGIN_TEST(testParseJSON_stream)
+{
+    StreamElements elements = { 0, JSVAL_VOID };
+    jsval v;
+
+    // Top-level array elements are delivered as they complete.
+    JSONStreamParser *sp = JS_BeginJSONStreamParse(cx, CountElement, &elements);
+    CHECK(sp);
+    CHECK(Consume(cx, sp, " [1, {\"a\": [2"));
+    CHECK(elements.count == 1);
+    CHECK_SAME(elements.last, INT_TO_JSVAL(1));
+    CHECK(Consume(cx, sp, ", 3]}, \"x],\\\"\""));
+    CHECK(elements.count == 2);
+    CHECK(Consume(cx, sp, "]  "));
+    CHECK(elements.count == 3);
+    CHECK(JSVAL_IS_STRING(elements.last));
+    CHECK(JS_FinishJSONStreamParse(cx, sp, &v));
+    CHECK_SAME(v, JSVAL_VOID);
+
+    // Empty arrays produce no elements.
+    elements.count = 0;
+    sp = JS_BeginJSONStreamParse(cx, CountElement, &elements);
+    CHECK(sp);
+    CHECK(Consume(cx, sp, "[ "));
+    CHECK(Consume(cx, sp, "]"));
+    CHECK(JS_FinishJSONStreamParse(cx, sp, &v));
+    CHECK(elements.count == 0);
+
+    // Without a callback the whole value is returned.
+    sp = JS_BeginJSONStreamParse(cx, NULL, NULL);
+    CHECK(sp);
+    CHECK(Consume(cx, sp, "{\"f\""));
+    CHECK(Consume(cx, sp, ": 17}"));
+    CHECK(JS_FinishJSONStreamParse(cx, sp, &v));
+    CHECK(!JSVAL_IS_PRIMITIVE(v));
+    jsval v2;
+    CHECK(JS_GetProperty(cx, JSVAL_TO_OBJECT(v), "f", &v2));
+    CHECK_SAME(v2, INT_TO_JSVAL(17));
+
+    // Errors are reported, and so are the calls after one. The parser can
+    // still be finished.
+    sp = JS_BeginJSONStreamParse(cx, CountElement, &elements);
+    CHECK(sp);
+    errorCount = 0;
+    JSErrorReporter old = JS_SetErrorReporter(cx, CountError);
+    JSBool ok = Consume(cx, sp, "[1,]");
+    JSBool okAfterError = Consume(cx, sp, "2]");
+    JSBool finished = JS_FinishJSONStreamParse(cx, sp, &v);
+    JS_SetErrorReporter(cx, old);
+    CHECK(!ok);
+    CHECK(!okAfterError);
+    CHECK(!finished);
+    CHECK_EQUAL(errorCount, 3);
+
+    sp = JS_BeginJSONStreamParse(cx, CountElement, &elements);
+    CHECK(sp);
+    CHECK(Consume(cx, sp, "[1"));
+    errorCount = 0;
+    old = JS_SetErrorReporter(cx, CountError);
+    ok = JS_FinishJSONStreamParse(cx, sp, &v);
+    JS_SetErrorReporter(cx, old);
+    CHECK(!ok);
+    CHECK_EQUAL(errorCount, 1);
+
+    return true;
+}
+
+template<size_t N> inline bool
+Consume(JSContext *cx, JSONStreamParser *sp, const char (&input)[N])
+{
+    AutoInflatedString str(cx);
+    str = input;
+    return JS_ConsumeJSONStreamText(cx, sp, str.chars(), str.length());
+}
+
+static void
+CountError(JSContext *cx, const char *message, JSErrorReport *report)
+{
+    errorCount++;
+}
+END_TEST(testParseJSON_stream)
@@ -72,6 +72,7 @@
 #include "jsnativestack.h"
 #include "jsnum.h"
 #include "json.h"
+#include "jsonparser.h"
 #include "jsobj.h"
 #include "jsopcode.h"
 #include "jsprobes.h"
@@ -725,6 +726,8 @@ JSRuntime::JSRuntime()
     checkRequestDepth(0),
 # endif
 #endif
+    gcChunkAddressMin(uintptr_t(-1)),
+    gcChunkAddressLimit(0),
     gcSystemAvailableChunkListHead(NULL),
     gcUserAvailableChunkListHead(NULL),
     gcKeepAtoms(0),
@@ -734,6 +737,9 @@ JSRuntime::JSRuntime()
     gcNumArenasFreeCommitted(0),
     gcVerifyData(NULL),
     gcChunkAllocationSinceLastGC(false),
+    gcLastGCTime(0),
+    gcHighFrequencyGC(false),
+    gcHighFrequencyTimeThreshold(1000),
     gcNextFullGCTime(0),
     gcJitReleaseTime(0),
     gcMode(JSGC_MODE_GLOBAL),
@@ -2947,6 +2953,9 @@ JS_SetGCParameter(JSRuntime *rt, JSGCParamKey key, uint32_t value)
       case JSGC_MARK_STACK_LIMIT:
         js::SetMarkStackLimit(rt, value);
         break;
+      case JSGC_HIGH_FREQUENCY_TIME_LIMIT:
+        rt->gcHighFrequencyTimeThreshold = value;
+        break;
       default:
         JS_ASSERT(key == JSGC_MODE);
         rt->gcMode = JSGCMode(value);
@@ -2977,6 +2986,8 @@ JS_GetGCParameter(JSRuntime *rt, JSGCParamKey key)
         return uint32_t(rt->gcSliceBudget > 0 ? rt->gcSliceBudget / PRMJ_USEC_PER_MSEC : 0);
       case JSGC_MARK_STACK_LIMIT:
         return rt->gcMarker.sizeLimit();
+      case JSGC_HIGH_FREQUENCY_TIME_LIMIT:
+        return rt->gcHighFrequencyTimeThreshold;
       default:
         JS_ASSERT(key == JSGC_NUMBER);
         return uint32_t(rt->gcNumber);
@@ -5968,6 +5979,32 @@ JS_ParseJSONWithReviver(JSContext *cx, const jschar *chars, uint32_t len, jsval
     return ParseJSONWithReviver(cx, chars, len, reviver, vp);
 }
 
+JS_PUBLIC_API(JSONStreamParser *)
+JS_BeginJSONStreamParse(JSContext *cx, JSONElementCallback callback, void *data)
+{
+    CHECK_REQUEST(cx);
+
+    return cx->new_<JSONStreamParser>(callback, data);
+}
+
+JS_PUBLIC_API(JSBool)
+JS_ConsumeJSONStreamText(JSContext *cx, JSONStreamParser *sp, const jschar *chars, uint32_t len)
+{
+    CHECK_REQUEST(cx);
+
+    return sp->consume(cx, chars, len);
+}
+
+JS_PUBLIC_API(JSBool)
+JS_FinishJSONStreamParse(JSContext *cx, JSONStreamParser *sp, jsval *vp)
+{
+    CHECK_REQUEST(cx);
+
+    JSBool ok = sp->finish(cx, vp);
+    Foreground::delete_(sp);
+    return ok;
+}
+
 JS_PUBLIC_API(JSBool)
 JS_ReadStructuredClone(JSContext *cx, const uint64_t *buf, size_t nbytes,
                        uint32_t version, jsval *vp,
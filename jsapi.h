@@ -3564,7 +3564,13 @@ typedef enum JSGCParamKey {
     JSGC_SLICE_TIME_BUDGET = 9,
 
     /* Maximum size the GC mark stack can grow to. */
-    JSGC_MARK_STACK_LIMIT = 10
+    JSGC_MARK_STACK_LIMIT = 10,
+
+    /*
+     * GCs less than this many milliseconds apart are considered high
+     * frequency, and the heap may grow more before the next one.
+     */
+    JSGC_HIGH_FREQUENCY_TIME_LIMIT = 11
 } JSGCParamKey;
 
 typedef enum JSGCMode {
@@ -5176,6 +5182,30 @@ JS_PUBLIC_API(JSBool)
 JS_ParseJSONWithReviver(JSContext *cx, const jschar *chars, uint32_t len, jsval reviver,
                         jsval *vp);
 
+/*
+ * Incremental JSON.parse for data that arrives in pieces. Pass each piece to
+ * JS_ConsumeJSONStreamText as it arrives, then call JS_FinishJSONStreamParse
+ * exactly once. That call frees the parser, even if an earlier call failed.
+ *
+ * If callback is non-null and the data is an array, each element is passed
+ * to the callback as soon as it has been parsed and *vp is set to undefined.
+ * Only the text of the element being received is kept in memory. Otherwise
+ * the whole input is buffered, and JS_FinishJSONStreamParse parses it and
+ * stores the parsed value in *vp.
+ *
+ * Once a call has failed, later calls for the same parser report an error.
+ */
+typedef JSBool (* JSONElementCallback)(JSContext *cx, jsval v, void *data);
+
+JS_PUBLIC_API(JSONStreamParser *)
+JS_BeginJSONStreamParse(JSContext *cx, JSONElementCallback callback, void *data);
+
+JS_PUBLIC_API(JSBool)
+JS_ConsumeJSONStreamText(JSContext *cx, JSONStreamParser *sp, const jschar *chars, uint32_t len);
+
+JS_PUBLIC_API(JSBool)
+JS_FinishJSONStreamParse(JSContext *cx, JSONStreamParser *sp, jsval *vp);
+
 /************************************************************************/
 
 /* API for the HTML5 internal structured cloning algorithm. */
@@ -2207,6 +2207,78 @@ SortComparatorFunction::operator()(const Value &a, const Value &b, bool *lessOrE
     return true;
 }
 
+/*
+ * Numeric comparators such as |function (a, b) { return a - b; }| are common
+ * enough that it pays to recognize their bytecode and compare the elements
+ * natively instead of invoking the function for every comparison.
+ */
+enum ComparatorMatchResult {
+    Match_None = 0,
+    Match_LeftMinusRight,
+    Match_RightMinusLeft
+};
+
+static ComparatorMatchResult
+MatchNumericComparator(JSContext *cx, const Value &v)
+{
+    if (!v.isObject() || !v.toObject().isFunction())
+        return Match_None;
+
+    JSFunction *fun = v.toObject().toFunction();
+    if (!fun->isInterpreted())
+        return Match_None;
+
+    /* Breakpoints and step hooks in the comparator must still be honored. */
+    if (cx->compartment->debugMode())
+        return Match_None;
+
+    jsbytecode *pc = fun->script()->code;
+
+    if (JSOp(*pc) != JSOP_GETARG)
+        return Match_None;
+    unsigned arg0 = GET_ARGNO(pc);
+    pc += JSOP_GETARG_LENGTH;
+
+    if (JSOp(*pc) != JSOP_GETARG)
+        return Match_None;
+    unsigned arg1 = GET_ARGNO(pc);
+    pc += JSOP_GETARG_LENGTH;
+
+    if (JSOp(*pc) != JSOP_SUB)
+        return Match_None;
+    pc += JSOP_SUB_LENGTH;
+
+    if (JSOp(*pc) != JSOP_RETURN)
+        return Match_None;
+
+    if (arg0 == 0 && arg1 == 1)
+        return Match_LeftMinusRight;
+    if (arg0 == 1 && arg1 == 0)
+        return Match_RightMinusLeft;
+    return Match_None;
+}
+
+/*
+ * Only used when every element is a number other than NaN, so that the
+ * subtraction has no side effects and the comparison is consistent. The
+ * result is computed exactly as the matched script would compute it.
+ */
+struct SortComparatorNumeric
+{
+    const bool leftMinusRight;
+
+    SortComparatorNumeric(bool leftMinusRight)
+      : leftMinusRight(leftMinusRight) {}
+
+    bool operator()(const Value &a, const Value &b, bool *lessOrEqualp) {
+        double cmp = leftMinusRight
+                     ? a.toNumber() - b.toNumber()
+                     : b.toNumber() - a.toNumber();
+        *lessOrEqualp = (MOZ_DOUBLE_IS_NaN(cmp) || cmp <= 0);
+        return true;
+    }
+};
+
 } /* namespace anonymous */
 
 JSBool
@@ -2277,6 +2349,7 @@ js::array_sort(JSContext *cx, unsigned argc, Value *vp)
         undefs = 0;
         bool allStrings = true;
         bool allInts = true;
+        bool allNumbers = true;
         for (uint32_t i = 0; i < len; i++) {
             if (!JS_CHECK_OPERATION_LIMIT(cx))
                 return false;
@@ -2295,6 +2368,7 @@ js::array_sort(JSContext *cx, unsigned argc, Value *vp)
             vec.infallibleAppend(v);
             allStrings = allStrings && v.isString();
             allInts = allInts && v.isInt32();
+            allNumbers = allNumbers && v.isNumber() && !MOZ_DOUBLE_IS_NaN(v.toNumber());
         }
 
         n = vec.length();
@@ -2361,10 +2435,20 @@ js::array_sort(JSContext *cx, unsigned argc, Value *vp)
                 result = vec.begin() + n;
             }
         } else {
-            InvokeArgsGuard args;
-            if (!MergeSort(vec.begin(), n, vec.begin() + n,
-                           SortComparatorFunction(cx, fval, args))) {
-                return false;
+            ComparatorMatchResult comp = allNumbers
+                                         ? MatchNumericComparator(cx, fval)
+                                         : Match_None;
+            if (comp != Match_None) {
+                if (!MergeSort(vec.begin(), n, vec.begin() + n,
+                               SortComparatorNumeric(comp == Match_LeftMinusRight))) {
+                    return false;
+                }
+            } else {
+                InvokeArgsGuard args;
+                if (!MergeSort(vec.begin(), n, vec.begin() + n,
+                               SortComparatorFunction(cx, fval, args))) {
+                    return false;
+                }
             }
         }
 
@@ -3003,6 +3087,42 @@ js::array_concat(JSContext *cx, unsigned argc, Value *vp)
                 uint32_t alength;
                 if (!js_GetLengthProperty(cx, obj, &alength))
                     return false;
+
+                /*
+                 * Copy fully initialized dense arrays in bulk. Holes are
+                 * copied as holes, which matches skipping them below.
+                 */
+                if (alength != 0 &&
+                    nobj->isDenseArray() && obj->isDenseArray() &&
+                    alength == obj->getDenseArrayInitializedLength() &&
+                    !js_PrototypeHasIndexedProperties(cx, nobj) &&
+                    !js_PrototypeHasIndexedProperties(cx, obj))
+                {
+                    JSObject::EnsureDenseResult result =
+                        nobj->ensureDenseArrayElements(cx, length, alength);
+                    if (result == JSObject::ED_FAILED)
+                        return false;
+                    if (result == JSObject::ED_OK) {
+                        if (!InitArrayTypes(cx, nobj->getType(cx),
+                                            obj->getDenseArrayElements(), alength)) {
+                            return false;
+                        }
+                        const Value *src = obj->getDenseArrayElements();
+                        nobj->copyDenseArrayElements(length, src, alength);
+                        for (uint32_t slot = 0; slot < alength; slot++) {
+                            if (src[slot].isMagic(JS_ARRAY_HOLE)) {
+                                nobj->markDenseArrayNotPacked(cx);
+                                break;
+                            }
+                        }
+                        length += alength;
+                        if (length > nobj->getArrayLength())
+                            nobj->setDenseArrayLength(length);
+                        continue;
+                    }
+                    JS_ASSERT(result == JSObject::ED_SPARSE);
+                }
+
                 for (uint32_t slot = 0; slot < alength; slot++) {
                     JSBool hole;
                     Value tmp;
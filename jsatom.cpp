@@ -278,6 +278,9 @@ js::SweepAtomState(JSRuntime *rt)
 {
     JSAtomState *state = &rt->atomState;
 
+    /* The cache holds no strong references; drop any atom about to die. */
+    state->atomizeCache.purge();
+
     for (AtomSet::Enum e(state->atoms); !e.empty(); e.popFront()) {
         AtomStateEntry entry = e.front();
 
@@ -306,6 +309,21 @@ AtomIsInterned(JSContext *cx, JSAtom *atom)
     return p->isTagged();
 }
 
+inline JSAtom *
+js::AtomizeCache::lookup(const jschar *chars, size_t length, bool intern) const
+{
+    const Entry &e = entries[index(chars, length)];
+    JSAtom *atom = e.atom;
+    if (!atom || atom->length() != length || (intern && !e.interned))
+        return NULL;
+    if (!PodEqual(atom->chars(), chars, length))
+        return NULL;
+
+    /* As in AtomStateEntry::asPtr, the atom may be weakly held. */
+    JSString::readBarrier(atom);
+    return atom;
+}
+
 enum OwnCharsBehavior
 {
     CopyChars, /* in other words, do not take ownership */
@@ -327,12 +345,17 @@ AtomizeInline(JSContext *cx, const jschar **pchars, size_t length,
     if (JSAtom *s = cx->runtime->staticStrings.lookup(chars, length))
         return s;
 
+    AtomizeCache &cache = cx->runtime->atomState.atomizeCache;
+    if (JSAtom *atom = cache.lookup(chars, length, bool(ib)))
+        return atom;
+
     AtomSet &atoms = cx->runtime->atomState.atoms;
     AtomSet::AddPtr p = atoms.lookupForAdd(AtomHasher::Lookup(chars, length));
 
     if (p) {
         JSAtom *atom = p->asPtr();
         p->setTagged(bool(ib));
+        cache.fill(chars, length, atom, p->isTagged());
         return atom;
     }
 
@@ -368,7 +391,9 @@ AtomizeInline(JSContext *cx, const jschar **pchars, size_t length,
         return NULL;
     }
 
-    return key->morphAtomizedStringIntoAtom();
+    JSAtom *atom = key->morphAtomizedStringIntoAtom();
+    cache.fill(chars, length, atom, bool(ib));
+    return atom;
 }
 
 static JSAtom *
@@ -227,6 +227,53 @@ struct AtomHasher
 
 typedef HashSet<AtomStateEntry, AtomHasher, SystemAllocPolicy> AtomSet;
 
+/*
+ * Direct-mapped cache in front of the atoms table. Most atomizations find an
+ * existing atom, and for those the cost is dominated by hashing every char
+ * and probing the AtomSet. The cache is indexed by a fingerprint of the
+ * length and three chars, so a hit costs one char-by-char comparison with
+ * the cached atom and no full hash. Entries are weak: hits apply the read
+ * barrier, and the cache is purged whenever the atoms table is swept.
+ */
+class AtomizeCache
+{
+    static const size_t SIZE_LOG2 = 8;
+    static const size_t SIZE = JS_BIT(SIZE_LOG2);
+
+    struct Entry {
+        JSAtom  *atom;
+        bool    interned;
+    };
+
+    Entry entries[SIZE];
+
+    static size_t index(const jschar *chars, size_t length) {
+        if (length == 0)
+            return 0;
+        uint32_t h = uint32_t(length) ^ (uint32_t(chars[0]) << 7) ^
+                     (uint32_t(chars[length >> 1]) << 14) ^
+                     (uint32_t(chars[length - 1]) << 21);
+        return (h * JS_GOLDEN_RATIO) >> (32 - SIZE_LOG2);
+    }
+
+  public:
+    AtomizeCache() { purge(); }
+
+    void purge() { PodArrayZero(entries); }
+
+    /*
+     * Return the cached atom for chars, or NULL. When intern is set only an
+     * atom already known to be interned is returned.
+     */
+    inline JSAtom *lookup(const jschar *chars, size_t length, bool intern) const;
+
+    void fill(const jschar *chars, size_t length, JSAtom *atom, bool interned) {
+        Entry &e = entries[index(chars, length)];
+        e.atom = atom;
+        e.interned = interned;
+    }
+};
+
 /*
  * On encodings:
  *
@@ -257,6 +304,7 @@ class PropertyName;
 struct JSAtomState
 {
     js::AtomSet         atoms;
+    js::AtomizeCache    atomizeCache;
 
     /*
      * From this point until the end of struct definition the struct must
@@ -492,6 +492,15 @@ struct JSRuntime : js::RuntimeFriendFields
      */
     js::GCChunkSet      gcChunkSet;
 
+    /*
+     * Address range covering every chunk in gcChunkSet. The range may be
+     * larger than needed after chunks are released; it is recomputed at the
+     * start of each conservative stack scan. Words outside of it are rejected
+     * without a hash lookup.
+     */
+    uintptr_t           gcChunkAddressMin;
+    uintptr_t           gcChunkAddressLimit;
+
     /*
      * Doubly-linked lists of chunks from user and system compartments. The GC
      * allocates its arenas from the corresponding list and when all arenas
@@ -519,6 +528,16 @@ struct JSRuntime : js::RuntimeFriendFields
     js::GCMarker        gcMarker;
     void                *gcVerifyData;
     bool                gcChunkAllocationSinceLastGC;
+
+    /*
+     * End time of the last GC cycle, and whether it followed the previous one
+     * within gcHighFrequencyTimeThreshold milliseconds. While GCs are that
+     * frequent, the heap is allowed to grow more between them.
+     */
+    int64_t             gcLastGCTime;
+    bool                gcHighFrequencyGC;
+    uint32_t            gcHighFrequencyTimeThreshold;
+
     int64_t             gcNextFullGCTime;
     int64_t             gcJitReleaseTime;
     JSGCMode            gcMode;
@@ -106,6 +106,7 @@
 #include "jsxml.h"
 #endif
 
+#include "ds/Sort.h"
 #include "frontend/Parser.h"
 #include "gc/Marking.h"
 #include "gc/Memory.h"
@@ -156,6 +157,17 @@ const size_t GC_ALLOCATION_THRESHOLD = 30 * 1024 * 1024;
  */
 const float GC_HEAP_GROWTH_FACTOR = 3.0f;
 
+/*
+ * While GCs run back to back (see JSRuntime::gcHighFrequencyGC), small heaps
+ * may grow up to GC_HIGH_FREQUENCY_HEAP_GROWTH_MAX times their live size
+ * before the next GC. The factor falls linearly back to GC_HEAP_GROWTH_FACTOR
+ * between GC_HIGH_FREQUENCY_LOW_LIMIT and GC_HIGH_FREQUENCY_HIGH_LIMIT of live
+ * data, so that large heaps do not balloon.
+ */
+const float GC_HIGH_FREQUENCY_HEAP_GROWTH_MAX = 5.0f;
+const size_t GC_HIGH_FREQUENCY_LOW_LIMIT = 100 * 1024 * 1024;
+const size_t GC_HIGH_FREQUENCY_HIGH_LIMIT = 500 * 1024 * 1024;
+
 /* Perform a Full GC every 20 seconds if MaybeGC is called */
 static const uint64_t GC_IDLE_FULL_SPAN = 20 * 1000 * 1000;
 
@@ -485,6 +497,8 @@ ChunkPool::get(JSRuntime *rt)
 {
     JS_ASSERT(this == &rt->gcChunkPool);
 
+    ++demandSinceExpire;
+
     Chunk *chunk = emptyChunkListHead;
     if (chunk) {
         JS_ASSERT(emptyCount);
@@ -530,7 +544,16 @@ ChunkPool::expire(JSRuntime *rt, bool releaseAll)
      * other chunks in the list. This way, if the GC runs several times
      * without emptying the list, the older chunks will stay at the tail
      * and are more likely to reach the max age.
+     *
+     * Old chunks are kept nevertheless as long as the pool holds fewer
+     * chunks than were taken from it since the last expiration. A runtime
+     * that goes through that many chunks between GCs would otherwise unmap
+     * them here only to map them again right after.
      */
+    size_t keep = releaseAll ? 0 : demandSinceExpire;
+    demandSinceExpire = 0;
+
+    size_t kept = 0;
     Chunk *freeList = NULL;
     for (Chunk **chunkp = &emptyChunkListHead; *chunkp; ) {
         JS_ASSERT(emptyCount);
@@ -538,7 +561,7 @@ ChunkPool::expire(JSRuntime *rt, bool releaseAll)
         JS_ASSERT(chunk->unused());
         JS_ASSERT(!rt->gcChunkSet.has(chunk));
         JS_ASSERT(chunk->info.age <= MAX_EMPTY_CHUNK_AGE);
-        if (releaseAll || chunk->info.age == MAX_EMPTY_CHUNK_AGE) {
+        if (releaseAll || (chunk->info.age == MAX_EMPTY_CHUNK_AGE && kept >= keep)) {
             *chunkp = chunk->info.next;
             --emptyCount;
             chunk->prepareToBeFreed(rt);
@@ -546,7 +569,9 @@ ChunkPool::expire(JSRuntime *rt, bool releaseAll)
             freeList = chunk;
         } else {
             /* Keep the chunk but increase its age. */
-            ++chunk->info.age;
+            if (chunk->info.age < MAX_EMPTY_CHUNK_AGE)
+                ++chunk->info.age;
+            ++kept;
             chunkp = &chunk->info.next;
         }
     }
@@ -858,6 +883,9 @@ PickChunk(JSCompartment *comp)
         return NULL;
     }
 
+    rt->gcChunkAddressMin = Min(rt->gcChunkAddressMin, uintptr_t(chunk));
+    rt->gcChunkAddressLimit = Max(rt->gcChunkAddressLimit, uintptr_t(chunk) + ChunkSize);
+
     chunk->info.prevp = NULL;
     chunk->info.next = NULL;
     chunk->addToAvailableList(comp);
@@ -991,6 +1019,10 @@ IsAddressableGCThing(JSRuntime *rt, uintptr_t w,
     uintptr_t addr = w & JSID_PAYLOAD_MASK & JSVAL_PAYLOAD_MASK;
 #endif
 
+    /* Most words on the stack are nowhere near the GC heap. */
+    if (addr < rt->gcChunkAddressMin || addr >= rt->gcChunkAddressLimit)
+        return CGCT_NOTCHUNK;
+
     Chunk *chunk = Chunk::fromAddress(addr);
 
     if (!rt->gcChunkSet.has(chunk))
@@ -1164,6 +1196,20 @@ MarkConservativeStackRoots(JSTracer *trc, bool useSavedRoots)
         return;
     }
 
+    /*
+     * Chunks may have been released since the range was last computed, so
+     * tighten it before scanning. The background thread cannot add or remove
+     * chunks while the GC runs.
+     */
+    uintptr_t chunkMin = uintptr_t(-1), chunkLimit = 0;
+    for (GCChunkSet::Range r(rt->gcChunkSet.all()); !r.empty(); r.popFront()) {
+        uintptr_t addr = uintptr_t(r.front());
+        chunkMin = Min(chunkMin, addr);
+        chunkLimit = Max(chunkLimit, addr + ChunkSize);
+    }
+    rt->gcChunkAddressMin = chunkMin;
+    rt->gcChunkAddressLimit = chunkLimit;
+
     uintptr_t *stackMin, *stackEnd;
 #if JS_STACK_GROWTH_DIRECTION > 0
     stackMin = rt->nativeStackBase;
@@ -1393,19 +1439,38 @@ js_MapGCRoots(JSRuntime *rt, JSGCRootMapFun map, void *data)
     return ct;
 }
 
+static float
+ComputeHeapGrowthFactor(JSRuntime *rt, size_t lastBytes)
+{
+    if (!rt->gcHighFrequencyGC || lastBytes >= GC_HIGH_FREQUENCY_HIGH_LIMIT)
+        return GC_HEAP_GROWTH_FACTOR;
+    if (lastBytes <= GC_HIGH_FREQUENCY_LOW_LIMIT)
+        return GC_HIGH_FREQUENCY_HEAP_GROWTH_MAX;
+
+    float k = float(lastBytes - GC_HIGH_FREQUENCY_LOW_LIMIT) /
+              float(GC_HIGH_FREQUENCY_HIGH_LIMIT - GC_HIGH_FREQUENCY_LOW_LIMIT);
+    return GC_HIGH_FREQUENCY_HEAP_GROWTH_MAX -
+           k * (GC_HIGH_FREQUENCY_HEAP_GROWTH_MAX - GC_HEAP_GROWTH_FACTOR);
+}
+
 static size_t
-ComputeTriggerBytes(size_t lastBytes, size_t maxBytes, JSGCInvocationKind gckind)
+ComputeTriggerBytes(size_t lastBytes, size_t maxBytes, float growthFactor,
+                    JSGCInvocationKind gckind)
 {
     size_t base = gckind == GC_SHRINK ? lastBytes : Max(lastBytes, GC_ALLOCATION_THRESHOLD);
-    float trigger = float(base) * GC_HEAP_GROWTH_FACTOR;
+    float trigger = float(base) * growthFactor;
     return size_t(Min(float(maxBytes), trigger));
 }
 
 void
 JSCompartment::setGCLastBytes(size_t lastBytes, size_t lastMallocBytes, JSGCInvocationKind gckind)
 {
-    gcTriggerBytes = ComputeTriggerBytes(lastBytes, rt->gcMaxBytes, gckind);
-    gcTriggerMallocAndFreeBytes = ComputeTriggerBytes(lastMallocBytes, SIZE_MAX, gckind);
+    float growthFactor = gckind == GC_SHRINK
+                         ? GC_HEAP_GROWTH_FACTOR
+                         : ComputeHeapGrowthFactor(rt, lastBytes);
+    gcTriggerBytes = ComputeTriggerBytes(lastBytes, rt->gcMaxBytes, growthFactor, gckind);
+    gcTriggerMallocAndFreeBytes = ComputeTriggerBytes(lastMallocBytes, SIZE_MAX, growthFactor,
+                                                      gckind);
 }
 
 void
@@ -1637,6 +1702,15 @@ ArenaLists::backgroundFinalize(FreeOp *fop, ArenaHeader *listHead)
     } else {
         lists->backgroundFinalizeState[thingKind] = BFS_DONE;
     }
+
+    fop->runtime()->gcHelperThread.notifyBackgroundSweepProgress(al);
+}
+
+void
+ArenaLists::waitBackgroundFinalize(JSRuntime *rt, AllocKind thingKind)
+{
+    while (backgroundFinalizeState[thingKind] == BFS_RUN && rt->gcHelperThread.sweeping())
+        rt->gcHelperThread.waitBackgroundSweepProgress(&arenaLists[thingKind]);
 }
 #endif /* JS_THREADSAFE */
 
@@ -1734,18 +1808,28 @@ ArenaLists::refillFreeList(JSContext *cx, AllocKind thingKind)
          * However, checking for that is racy as the background finalization
          * could free some things after allocateFromArena decided to fail but
          * at this point it may have already stopped. To avoid this race we
-         * always try to allocate twice.
+         * always retry after waiting.
+         *
+         * While its kind is being finalized allocateFromArena takes new
+         * arenas from the chunks, so it only fails here when no chunk can be
+         * had. We then first wait only for the arena list of this kind to be
+         * published, which usually happens well before the whole sweep is
+         * done. If that does not give us any free things, we wait for the
+         * rest of the sweep to release its arenas to the chunks.
          */
-        for (bool secondAttempt = false; ; secondAttempt = true) {
+        for (unsigned attempt = 0; ; attempt++) {
             void *thing = comp->arenas.allocateFromArena(comp, thingKind);
             if (JS_LIKELY(!!thing))
                 return thing;
-            if (secondAttempt)
+            if (attempt == 2)
                 break;
 
             AutoLockGC lock(rt);
 #ifdef JS_THREADSAFE
-            rt->gcHelperThread.waitBackgroundSweepEnd();
+            if (attempt == 0)
+                comp->arenas.waitBackgroundFinalize(rt, thingKind);
+            else
+                rt->gcHelperThread.waitBackgroundSweepEnd();
 #endif
         }
 
@@ -2611,6 +2695,52 @@ DecommitArenas(JSRuntime *rt)
     DecommitArenasFromAvailableList(rt, &rt->gcUserAvailableChunkListHead);
 }
 
+struct ChunkFullerOrEqual
+{
+    bool operator()(Chunk *a, Chunk *b, bool *lessOrEqualp) {
+        *lessOrEqualp = a->info.numArenasFree <= b->info.numArenasFree;
+        return true;
+    }
+};
+
+/*
+ * Order the available list so that the chunks with the fewest free arenas
+ * come first. New arenas are then taken from the densest chunks, letting
+ * sparsely used chunks drain until they become empty and can be released,
+ * while DecommitArenasFromAvailableList, which walks the list from the tail,
+ * starts with the sparsest ones. Arenas are never relocated, so this is the
+ * only defence against a heap kept alive by a few live things per chunk.
+ *
+ * Must be called with the GC lock taken.
+ */
+static void
+SortAvailableChunkList(Chunk **listHeadp)
+{
+    Vector<Chunk *, 32, SystemAllocPolicy> chunks;
+    for (Chunk *chunk = *listHeadp; chunk; chunk = chunk->info.next) {
+        if (!chunks.append(chunk))
+            return;
+    }
+
+    size_t length = chunks.length();
+    if (length <= 1)
+        return;
+
+    /* On OOM, keep the current order. */
+    if (!chunks.growBy(length))
+        return;
+    if (!MergeSort(chunks.begin(), length, chunks.begin() + length, ChunkFullerOrEqual()))
+        return;
+
+    for (size_t i = 0; i < length; i++) {
+        chunks[i]->info.prevp = NULL;
+        chunks[i]->info.next = NULL;
+    }
+    *listHeadp = NULL;
+    for (size_t i = length; i != 0; i--)
+        chunks[i - 1]->insertToAvailableList(listHeadp);
+}
+
 /* Must be called with the GC lock taken. */
 static void
 ExpireChunksAndArenas(JSRuntime *rt, bool shouldShrink)
@@ -2620,6 +2750,9 @@ ExpireChunksAndArenas(JSRuntime *rt, bool shouldShrink)
         FreeChunkList(toFree);
     }
 
+    SortAvailableChunkList(&rt->gcSystemAvailableChunkListHead);
+    SortAvailableChunkList(&rt->gcUserAvailableChunkListHead);
+
     if (shouldShrink)
         DecommitArenas(rt);
 }
@@ -2761,6 +2894,8 @@ GCHelperThread::startBackgroundSweep(bool shouldShrink)
     JS_ASSERT(!sweepFlag);
     sweepFlag = true;
     shrinkFlag = shouldShrink;
+    sweepGCNumber = rt->gcNumber;
+    rt->gcStats.beginBackgroundSweep();
     state = SWEEPING;
     PR_NotifyCondVar(wakeup);
 }
@@ -2799,6 +2934,26 @@ GCHelperThread::waitBackgroundSweepEnd()
         PR_WaitCondVar(done, PR_INTERVAL_NO_TIMEOUT);
 }
 
+/* Must be called with the GC lock taken. */
+void
+GCHelperThread::waitBackgroundSweepProgress(const ArenaList *al)
+{
+    if (state == SWEEPING) {
+        JS_ASSERT(!awaitedArenaList);
+        awaitedArenaList = al;
+        PR_WaitCondVar(done, PR_INTERVAL_NO_TIMEOUT);
+        awaitedArenaList = NULL;
+    }
+}
+
+/* Must be called with the GC lock taken. */
+void
+GCHelperThread::notifyBackgroundSweepProgress(const ArenaList *al)
+{
+    if (al == awaitedArenaList)
+        PR_NotifyAllCondVar(done);
+}
+
 /* Must be called with the GC lock taken. */
 void
 GCHelperThread::waitBackgroundSweepOrAllocEnd()
@@ -2838,35 +2993,46 @@ GCHelperThread::replenishAndFreeLater(void *ptr)
     Foreground::free_(ptr);
 }
 
+/* Must be called with the GC lock taken. */
+void
+GCHelperThread::finalizeAndFree()
+{
+    AutoUnlockGC unlock(rt);
+
+    /*
+     * We must finalize in the insert order, see comments in
+     * finalizeObjects.
+     */
+    FreeOp fop(rt, false, true);
+    for (ArenaHeader **i = finalizeVector.begin(); i != finalizeVector.end(); ++i)
+        ArenaLists::backgroundFinalize(&fop, *i);
+    finalizeVector.resize(0);
+
+    if (freeCursor) {
+        void **array = freeCursorEnd - FREE_ARRAY_LENGTH;
+        freeElementsAndArray(array, freeCursor);
+        freeCursor = freeCursorEnd = NULL;
+    } else {
+        JS_ASSERT(!freeCursorEnd);
+    }
+    for (void ***iter = freeVector.begin(); iter != freeVector.end(); ++iter) {
+        void **array = *iter;
+        freeElementsAndArray(array, array + FREE_ARRAY_LENGTH);
+    }
+    freeVector.resize(0);
+}
+
 /* Must be called with the GC lock taken. */
 void
 GCHelperThread::doSweep()
 {
     if (sweepFlag) {
         sweepFlag = false;
-        AutoUnlockGC unlock(rt);
 
-        /*
-         * We must finalize in the insert order, see comments in
-         * finalizeObjects.
-         */
-        FreeOp fop(rt, false, true);
-        for (ArenaHeader **i = finalizeVector.begin(); i != finalizeVector.end(); ++i)
-            ArenaLists::backgroundFinalize(&fop, *i);
-        finalizeVector.resize(0);
-
-        if (freeCursor) {
-            void **array = freeCursorEnd - FREE_ARRAY_LENGTH;
-            freeElementsAndArray(array, freeCursor);
-            freeCursor = freeCursorEnd = NULL;
-        } else {
-            JS_ASSERT(!freeCursorEnd);
-        }
-        for (void ***iter = freeVector.begin(); iter != freeVector.end(); ++iter) {
-            void **array = *iter;
-            freeElementsAndArray(array, array + FREE_ARRAY_LENGTH);
-        }
-        freeVector.resize(0);
+        /* Chunk expiry below is not part of the GC, so it is not timed. */
+        int64_t start = PRMJ_Now();
+        finalizeAndFree();
+        rt->gcStats.endBackgroundSweep(sweepGCNumber, PRMJ_Now() - start, rt->gcBytes);
     }
 
     bool shrinking = shrinkFlag;
@@ -3300,6 +3466,12 @@ SweepPhase(JSRuntime *rt, JSGCInvocationKind gckind, bool *startBackgroundSweep)
             rt->gcFinalizeCallback(&fop, JSFINALIZE_END);
     }
 
+    int64_t now = PRMJ_Now();
+    rt->gcHighFrequencyGC =
+        rt->gcLastGCTime &&
+        now - rt->gcLastGCTime < int64_t(rt->gcHighFrequencyTimeThreshold) * PRMJ_USEC_PER_MSEC;
+    rt->gcLastGCTime = now;
+
     for (CompartmentsIter c(rt); !c.done(); c.next())
         c->setGCLastBytes(c->gcBytes, c->gcMallocAndFreeBytes, gckind);
 }
@@ -95,10 +95,14 @@ class ChunkPool {
     Chunk   *emptyChunkListHead;
     size_t  emptyCount;
 
+    /* Number of chunks handed out since the last call to expire. */
+    size_t  demandSinceExpire;
+
   public:
     ChunkPool()
       : emptyChunkListHead(NULL),
-        emptyCount(0) { }
+        emptyCount(0),
+        demandSinceExpire(0) { }
 
     size_t getEmptyCount() const {
         return emptyCount;
@@ -298,6 +302,13 @@ struct ArenaLists {
     bool doneBackgroundFinalize(AllocKind kind) const {
         return backgroundFinalizeState[kind] == BFS_DONE;
     }
+
+    /*
+     * Wait until the background finalization has published the arenas of the
+     * given kind, without waiting for the rest of the sweep. Must be called
+     * with the GC lock taken.
+     */
+    void waitBackgroundFinalize(JSRuntime *rt, AllocKind thingKind);
 #endif
 
     /*
@@ -591,6 +602,12 @@ class GCHelperThread {
     bool              sweepFlag;
     bool              shrinkFlag;
 
+    /* Number of the GC whose finalization the helper thread is doing. */
+    uint64_t          sweepGCNumber;
+
+    /* The arena list waitBackgroundSweepProgress is waiting for, or NULL. */
+    const js::gc::ArenaList *awaitedArenaList;
+
     Vector<void **, 16, js::SystemAllocPolicy> freeVector;
     void            **freeCursor;
     void            **freeCursorEnd;
@@ -614,6 +631,9 @@ class GCHelperThread {
     static void threadMain(void* arg);
     void threadLoop();
 
+    /* Must be called with the GC lock taken. */
+    void finalizeAndFree();
+
     /* Must be called with the GC lock taken. */
     void doSweep();
 
@@ -626,6 +646,8 @@ class GCHelperThread {
         state(IDLE),
         sweepFlag(false),
         shrinkFlag(false),
+        sweepGCNumber(0),
+        awaitedArenaList(NULL),
         freeCursor(NULL),
         freeCursorEnd(NULL),
         backgroundAllocation(true)
@@ -646,6 +668,18 @@ class GCHelperThread {
     /* Must be called with the GC lock taken. */
     void waitBackgroundSweepOrAllocEnd();
 
+    /*
+     * Wait until the background sweep publishes the given arena list or
+     * finishes. Must be called with the GC lock taken.
+     */
+    void waitBackgroundSweepProgress(const js::gc::ArenaList *al);
+
+    /*
+     * Wake up the main thread if it waits for the given arena list. Must be
+     * called with the GC lock taken.
+     */
+    void notifyBackgroundSweepProgress(const js::gc::ArenaList *al);
+
     /* Must be called with the GC lock taken. */
     inline void startBackgroundAllocationIfIdle();
 
@@ -1267,7 +1267,7 @@ js::AssertValidPropertyCacheHit(JSContext *cx,
     JS_ASSERT(ok);
 
     if (cx->runtime->gcNumber != sample)
-        JS_PROPERTY_CACHE(cx).restore(&savedEntry);
+        JS_PROPERTY_CACHE(cx).restore(entry, savedEntry);
     JS_ASSERT(prop);
     JS_ASSERT(pobj == found);
 
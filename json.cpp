@@ -209,6 +209,120 @@ Quote(JSContext *cx, StringBuffer &sb, JSString *str)
     return sb.append('"');
 }
 
+/*
+ * Plain objects with the same non-dictionary shape have the same own
+ * enumerable properties in the same order. Remember each shape's property
+ * list, with every name already quoted, so that JO can skip enumerating and
+ * quoting for later objects of that shape.
+ *
+ * A GC may free a shape and let its address be reused, so the shape table is
+ * cleared after any GC. The id and character vectors only grow, which keeps
+ * entries valid while JO is still iterating over them.
+ */
+class ShapeKeyCache
+{
+  public:
+    struct Entry {
+        size_t start;
+        size_t length;
+    };
+
+    ShapeKeyCache(JSContext *cx)
+      : ids(cx), quoteEnds(cx), quoted(cx), shapes(cx), gcNumber(cx->runtime->gcNumber)
+    {}
+
+    bool init() {
+        return shapes.init(16);
+    }
+
+    /*
+     * Set *entryp to the cached property list for obj, or to NULL if obj's
+     * properties can't be cached.
+     */
+    bool lookup(JSContext *cx, JSObject *obj, Entry *entryp, bool *foundp);
+
+    jsid id(size_t i) const {
+        return ids[i];
+    }
+
+    bool appendQuoted(size_t i, StringBuffer &sb) const {
+        size_t begin = i ? quoteEnds[i - 1] : 0;
+        return sb.append(quoted.begin() + begin, quoted.begin() + quoteEnds[i]);
+    }
+
+  private:
+    AutoIdVector ids;
+    Vector<size_t> quoteEnds;
+    StringBuffer quoted;
+    HashMap<Shape *, Entry> shapes;
+    uint64_t gcNumber;
+};
+
+bool
+ShapeKeyCache::lookup(JSContext *cx, JSObject *obj, Entry *entryp, bool *foundp)
+{
+    *foundp = false;
+
+#ifdef JS_MORE_DETERMINISTIC
+    /* Property names are sorted after enumeration in this configuration. */
+    return true;
+#endif
+
+    /* Objects without a prototype hide __proto__ from enumeration. */
+    if (!obj->isNative() || obj->getClass() != &ObjectClass || obj->inDictionaryMode() ||
+        !obj->getProto())
+    {
+        return true;
+    }
+
+    if (gcNumber != cx->runtime->gcNumber) {
+        shapes.clear();
+        gcNumber = cx->runtime->gcNumber;
+    }
+
+    Shape *shape = obj->lastProperty();
+    HashMap<Shape *, Entry>::AddPtr p = shapes.lookupForAdd(shape);
+    if (p) {
+        *entryp = p->value;
+        *foundp = true;
+        return true;
+    }
+
+    /* Collect the enumerable properties in the order GetPropertyNames uses. */
+    Entry entry = { ids.length(), 0 };
+    Shape::Range r = shape->all();
+    Shape::Range::Root root(cx, &r);
+    for (; !r.empty(); r.popFront()) {
+        const Shape &prop = r.front();
+        if (prop.enumerable() && !JSID_IS_DEFAULT_XML_NAMESPACE(prop.propid())) {
+            if (!ids.append(prop.propid()))
+                return false;
+        }
+    }
+    entry.length = ids.length() - entry.start;
+    ::Reverse(ids.begin() + entry.start, ids.end());
+
+    for (size_t i = entry.start; i < ids.length(); i++) {
+        JSString *str = IdToString(cx, ids[i]);
+        if (!str || !Quote(cx, quoted, str) || !quoteEnds.append(quoted.length()))
+            return false;
+    }
+
+    /* Quoting index names may have allocated and so run a GC. */
+    if (gcNumber != cx->runtime->gcNumber) {
+        shapes.clear();
+        gcNumber = cx->runtime->gcNumber;
+        if (!shapes.put(obj->lastProperty(), entry))
+            return false;
+    } else if (!shapes.add(p, obj->lastProperty(), entry)) {
+        return false;
+    }
+
+    *entryp = entry;
+    *foundp = true;
+    return true;
+}
+
 class StringifyContext
 {
   public:
@@ -219,11 +333,12 @@ class StringifyContext
         replacer(cx, replacer),
         propertyList(propertyList),
         depth(0),
-        objectStack(cx)
+        objectStack(cx),
+        keyCache(cx)
     {}
 
     bool init() {
-        return objectStack.init(16);
+        return objectStack.init(16) && keyCache.init();
     }
 
 #ifdef DEBUG
@@ -236,6 +351,7 @@ class StringifyContext
     const AutoIdVector &propertyList;
     uint32_t depth;
     HashSet<JSObject *> objectStack;
+    ShapeKeyCache keyCache;
 };
 
 static JSBool Str(JSContext *cx, const Value &v, StringifyContext *scx);
@@ -418,24 +534,28 @@ JO(JSContext *cx, HandleObject obj, StringifyContext *scx)
 
     /* Steps 5-7. */
     Maybe<AutoIdVector> ids;
-    const AutoIdVector *props;
+    const AutoIdVector *props = NULL;
+    ShapeKeyCache::Entry cached;
+    bool useCache = false;
     if (scx->replacer && !scx->replacer->isCallable()) {
         JS_ASSERT(JS_IsArrayObject(cx, scx->replacer));
         props = &scx->propertyList;
     } else {
         JS_ASSERT_IF(scx->replacer, scx->propertyList.length() == 0);
-        ids.construct(cx);
-        if (!GetPropertyNames(cx, obj, JSITER_OWNONLY, ids.addr()))
+        if (!scx->keyCache.lookup(cx, obj, &cached, &useCache))
             return false;
-        props = ids.addr();
+        if (!useCache) {
+            ids.construct(cx);
+            if (!GetPropertyNames(cx, obj, JSITER_OWNONLY, ids.addr()))
+                return false;
+            props = ids.addr();
+        }
     }
 
-    /* My kingdom for not-quite-initialized-from-the-start references. */
-    const AutoIdVector &propertyList = *props;
-
     /* Steps 8-10, 13. */
     bool wroteMember = false;
-    for (size_t i = 0, len = propertyList.length(); i < len; i++) {
+    size_t len = useCache ? cached.length : props->length();
+    for (size_t i = 0; i < len; i++) {
         /*
          * Steps 8a-8b.  Note that the call to Str is broken up into 1) getting
          * the property; 2) processing for toJSON, calling the replacer, and
@@ -443,7 +563,7 @@ JO(JSContext *cx, HandleObject obj, StringifyContext *scx)
          * values which process to |undefined|, and 4) stringifying all values
          * which pass the filter.
          */
-        const jsid &id = propertyList[i];
+        jsid id = useCache ? scx->keyCache.id(cached.start + i) : (*props)[i];
         Value outputValue;
         if (!obj->getGeneric(cx, id, &outputValue))
             return false;
@@ -460,12 +580,16 @@ JO(JSContext *cx, HandleObject obj, StringifyContext *scx)
         if (!WriteIndent(cx, scx, scx->depth))
             return false;
 
-        JSString *s = IdToString(cx, id);
-        if (!s)
-            return false;
+        if (useCache) {
+            if (!scx->keyCache.appendQuoted(cached.start + i, scx->sb))
+                return false;
+        } else {
+            JSString *s = IdToString(cx, id);
+            if (!s || !Quote(cx, scx->sb, s))
+                return false;
+        }
 
-        if (!Quote(cx, scx->sb, s) ||
-            !scx->sb.append(':') ||
+        if (!scx->sb.append(':') ||
             !(scx->gap.empty() || scx->sb.append(' ')) ||
             !Str(cx, outputValue, scx))
         {
@@ -590,11 +714,7 @@ Str(JSContext *cx, const Value &v, StringifyContext *scx)
                 return scx->sb.append("null");
         }
 
-        StringBuffer sb(cx);
-        if (!NumberValueToStringBuffer(cx, v, sb))
-            return false;
-
-        return scx->sb.append(sb.begin(), sb.length());
+        return NumberValueToStringBuffer(cx, v, scx->sb);
     }
 
     /* Step 10. */
@@ -61,6 +61,29 @@ JSONParser::errorReturn()
     return errorHandling == NoError;
 }
 
+JSAtom *
+JSONParser::atomizePropertyName(const jschar *chars, size_t length, uint32_t hash)
+{
+    JS_ASSERT(hash == HashChars(chars, length));
+
+    if (keyCacheGCNumber != cx->runtime->gcNumber) {
+        PodArrayZero(keyCache);
+        keyCacheGCNumber = cx->runtime->gcNumber;
+    }
+
+    JSAtom *&entry = keyCache[hash % KeyCacheSize];
+    if (entry && entry->length() == length && PodEqual(entry->chars(), chars, length)) {
+        JSString::readBarrier(entry);
+        return entry;
+    }
+
+    JSAtom *atom = js_AtomizeChars(cx, chars, length);
+    uint32_t index;
+    if (atom && !atom->isIndex(&index))
+        entry = atom;
+    return atom;
+}
+
 template<JSONParser::StringType ST>
 JSONParser::Token
 JSONParser::readString()
@@ -83,12 +106,13 @@ JSONParser::readString()
      * string directly from the source text.
      */
     RangedPtr<const jschar> start = current;
+    uint32_t hash = 0;
     for (; current < end; current++) {
         if (*current == '"') {
             size_t length = current - start;
             current++;
             JSFlatString *str = (ST == JSONParser::PropertyName)
-                                ? js_AtomizeChars(cx, start.get(), length)
+                                ? atomizePropertyName(start.get(), length, hash)
                                 : js_NewStringCopyN(cx, start.get(), length);
             if (!str)
                 return token(OOM);
@@ -102,6 +126,9 @@ JSONParser::readString()
             error("bad control character in string literal");
             return token(Error);
         }
+
+        if (ST == JSONParser::PropertyName)
+            hash = JS_ROTATE_LEFT32(hash, 4) ^ *current;
     }
 
     /*
@@ -526,6 +553,15 @@ JSONParser::parse(Value *vp)
     Vector<ParserState> stateStack(cx);
     AutoValueVector valueStack(cx);
 
+    /*
+     * Slot count of the last object completed at each nesting depth, used to
+     * size the next object at that depth so that sibling records fit in
+     * fixed slots. The depth of an object is the number of containers
+     * enclosing it, which is the length of stateStack while it is opened and
+     * once its last member is defined.
+     */
+    Vector<uint32_t, 8> objectSlotsHints(cx);
+
     *vp = UndefinedValue();
 
     Token token;
@@ -547,8 +583,13 @@ JSONParser::parse(Value *vp)
                 return false;
             }
             token = advanceAfterProperty();
-            if (token == ObjectClose)
+            if (token == ObjectClose) {
+                size_t depth = stateStack.length();
+                if (depth >= objectSlotsHints.length() && !objectSlotsHints.resize(depth + 1))
+                    return false;
+                objectSlotsHints[depth] = obj->slotSpan();
                 break;
+            }
             if (token != Comma) {
                 if (token == OOM)
                     return false;
@@ -636,7 +677,11 @@ JSONParser::parse(Value *vp)
               }
 
               case ObjectOpen: {
-                JSObject *obj = NewBuiltinClassInstance(cx, &ObjectClass);
+                size_t depth = stateStack.length();
+                uint32_t slotsHint =
+                    depth < objectSlotsHints.length() ? objectSlotsHints[depth] : 0;
+                gc::AllocKind kind = GuessObjectGCKind(slotsHint);
+                JSObject *obj = NewBuiltinClassInstance(cx, &ObjectClass, kind);
                 if (!obj || !valueStack.append(ObjectValue(*obj)))
                     return false;
                 token = advanceAfterObjectOpen();
@@ -695,3 +740,181 @@ JSONParser::parse(Value *vp)
     *vp = valueStack[0];
     return true;
 }
+
+bool
+JSONStreamParser::error(JSContext *cx, const char *msg)
+{
+    state = Failed;
+    JS_ReportErrorNumber(cx, js_GetErrorMessage, NULL, JSMSG_JSON_BAD_PARSE, msg);
+    return false;
+}
+
+bool
+JSONStreamParser::finishElement(JSContext *cx, size_t elementEnd, bool last)
+{
+    const jschar *chars = text.begin() + elementStart;
+    size_t length = elementEnd - elementStart;
+
+    /* An empty array has one empty "element" before the closing bracket. */
+    if (last && elementCount == 0) {
+        size_t i = 0;
+        while (i < length && IsJSONWhitespace(chars[i]))
+            i++;
+        if (i == length)
+            return true;
+    }
+
+    Value v;
+    RootValue vRoot(cx, &v);
+    JSONParser parser(cx, chars, length);
+    if (!parser.parse(&v)) {
+        state = Failed;
+        return false;
+    }
+    elementCount++;
+
+    if (!callback(cx, v, callbackData)) {
+        state = Failed;
+        return false;
+    }
+    return true;
+}
+
+bool
+JSONStreamParser::scanArray(JSContext *cx)
+{
+    JS_ASSERT(state == ArrayElement);
+
+    size_t length = text.length();
+    for (; scanned < length; scanned++) {
+        jschar c = text[scanned];
+        if (inString) {
+            if (escaped)
+                escaped = false;
+            else if (c == '\\')
+                escaped = true;
+            else if (c == '"')
+                inString = false;
+            continue;
+        }
+
+        switch (c) {
+          case '"':
+            inString = true;
+            break;
+
+          case '[':
+          case '{':
+            depth++;
+            break;
+
+          case '}':
+            if (depth == 0)
+                return error(cx, "unexpected character");
+            depth--;
+            break;
+
+          case ']':
+            if (depth > 0) {
+                depth--;
+                break;
+            }
+            /* FALL THROUGH */
+
+          case ',':
+            if (depth > 0)
+                break;
+            if (!finishElement(cx, scanned, c == ']'))
+                return false;
+            elementStart = scanned + 1;
+            if (c == ']') {
+                state = ArrayEnd;
+                scanned++;
+                return true;
+            }
+            break;
+        }
+    }
+    return true;
+}
+
+bool
+JSONStreamParser::consume(JSContext *cx, const jschar *chars, size_t length)
+{
+    if (state == Failed)
+        return error(cx, "parsing already failed");
+
+    if (state == ArrayEnd) {
+        for (size_t i = 0; i < length; i++) {
+            if (!IsJSONWhitespace(chars[i]))
+                return error(cx, "unexpected non-whitespace character after JSON data");
+        }
+        return true;
+    }
+
+    if (!text.append(chars, length)) {
+        state = Failed;
+        js_ReportOutOfMemory(cx);
+        return false;
+    }
+
+    if (state == Start) {
+        while (scanned < text.length() && IsJSONWhitespace(text[scanned]))
+            scanned++;
+        if (scanned == text.length())
+            return true;
+        if (callback && text[scanned] == '[') {
+            state = ArrayElement;
+            elementStart = ++scanned;
+        } else {
+            state = Buffering;
+        }
+    }
+
+    if (state == Buffering)
+        return true;
+
+    if (!scanArray(cx))
+        return false;
+
+    /* Drop the text of elements that have already been parsed. */
+    if (state == ArrayEnd) {
+        for (; scanned < text.length(); scanned++) {
+            if (!IsJSONWhitespace(text[scanned]))
+                return error(cx, "unexpected non-whitespace character after JSON data");
+        }
+        text.clear();
+        scanned = elementStart = 0;
+    } else if (elementStart > 0) {
+        size_t remaining = text.length() - elementStart;
+        memmove(text.begin(), text.begin() + elementStart, remaining * sizeof(jschar));
+        text.shrinkBy(elementStart);
+        scanned -= elementStart;
+        elementStart = 0;
+    }
+    return true;
+}
+
+bool
+JSONStreamParser::finish(JSContext *cx, Value *vp)
+{
+    *vp = UndefinedValue();
+
+    switch (state) {
+      case Start:
+      case Buffering: {
+        JSONParser parser(cx, text.begin(), text.length());
+        return parser.parse(vp);
+      }
+
+      case ArrayElement:
+        return error(cx, "unexpected end of data");
+
+      case ArrayEnd:
+        return true;
+
+      case Failed:
+        break;
+    }
+    return error(cx, "parsing already failed");
+}
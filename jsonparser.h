@@ -71,6 +71,18 @@ class JSONParser
     const ParsingMode parsingMode;
     const ErrorHandling errorHandling;
 
+    /*
+     * Records usually repeat the same property names, so keep the atoms for
+     * recently seen names to avoid a trip through the atom table for each.
+     * The cached atoms are not traced, so the cache is emptied whenever a GC
+     * has run since it was filled (keyCacheGCNumber), and index-like names,
+     * which become int ids and so may be held only by the cache, are never
+     * cached.
+     */
+    static const size_t KeyCacheSize = 64;
+    JSAtom *keyCache[KeyCacheSize];
+    uint64_t keyCacheGCNumber;
+
     enum Token { String, Number, True, False, Null,
                  ArrayOpen, ArrayClose,
                  ObjectOpen, ObjectClose,
@@ -99,12 +111,14 @@ class JSONParser
         end(data + length, data, length),
         root(cx, thisDuringConstruction()),
         parsingMode(parsingMode),
-        errorHandling(errorHandling)
+        errorHandling(errorHandling),
+        keyCacheGCNumber(cx->runtime->gcNumber)
 #ifdef DEBUG
       , lastToken(Error)
 #endif
     {
         JS_ASSERT(current <= end);
+        js::PodArrayZero(keyCache);
     }
 
     /*
@@ -165,6 +179,7 @@ class JSONParser
 
     enum StringType { PropertyName, LiteralValue };
     template<StringType ST> Token readString();
+    JSAtom *atomizePropertyName(const jschar *chars, size_t length, uint32_t hash);
 
     Token readNumber();
 
@@ -183,4 +198,51 @@ class JSONParser
     void operator=(const JSONParser &other) MOZ_DELETE;
 };
 
+/*
+ * Incremental front end for JSONParser, driven by the JS_*JSONStreamParse
+ * API. Text is accumulated in a private buffer as it arrives. When an element
+ * callback is given and the data is a top-level array, each element is parsed
+ * and passed to the callback as soon as its text is complete and that text is
+ * then discarded, so the whole array never has to be held in memory.
+ */
+class JSONStreamParser
+{
+    enum State { Start, Buffering, ArrayElement, ArrayEnd, Failed };
+
+    JSONElementCallback callback;
+    void *callbackData;
+
+    js::Vector<jschar, 0, js::SystemAllocPolicy> text;
+
+    State state;
+
+    /* Offsets into |text| of the next character to scan and the element. */
+    size_t scanned;
+    size_t elementStart;
+    uint32_t elementCount;
+
+    /* Nesting and string state within the current array element. */
+    uint32_t depth;
+    bool inString;
+    bool escaped;
+
+    bool error(JSContext *cx, const char *msg);
+    bool scanArray(JSContext *cx);
+    bool finishElement(JSContext *cx, size_t elementEnd, bool last);
+
+  public:
+    JSONStreamParser(JSONElementCallback callback, void *data)
+      : callback(callback), callbackData(data), state(Start), scanned(0), elementStart(0),
+        elementCount(0), depth(0), inString(false), escaped(false)
+    {}
+
+    bool consume(JSContext *cx, const jschar *chars, size_t length);
+
+    /*
+     * Parse any buffered data and store the result in *vp, or |undefined| if
+     * the elements were passed to the callback.
+     */
+    bool finish(JSContext *cx, js::Value *vp);
+};
+
 #endif /* jsonparser_h___ */
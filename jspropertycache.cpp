@@ -134,7 +134,7 @@ PropertyCache::fill(JSContext *cx, JSObject *obj, unsigned scopeIndex, JSObject
         }
     }
 
-    PropertyCacheEntry *entry = &table[hash(pc, obj->lastProperty())];
+    PropertyCacheEntry *entry = entryForFill(pc, obj->lastProperty());
     PCMETER(entry->vword.isNull() || recycles++);
     entry->assign(pc, obj->lastProperty(), pobj->lastProperty(), shape, scopeIndex, protoIndex);
 
@@ -150,6 +150,25 @@ PropertyCache::fill(JSContext *cx, JSObject *obj, unsigned scopeIndex, JSObject
     return entry;
 }
 
+PropertyCacheEntry *
+PropertyCache::entryForFill(jsbytecode *pc, const Shape *kshape)
+{
+    PropertyCacheEntry *set = table[hash(pc, kshape)];
+
+    /* Replace any stale entry for the same key in place. */
+    for (unsigned i = 0; i < WAYS; i++) {
+        if (set[i].kpc == pc && set[i].kshape == kshape)
+            return &set[i];
+    }
+
+    /* Otherwise make room at the front, dropping the oldest entry. */
+    if (set[WAYS - 1].kpc)
+        PCSTAT(stats.evictions++);
+    for (unsigned i = WAYS - 1; i > 0; i--)
+        set[i] = set[i - 1];
+    return &set[0];
+}
+
 PropertyName *
 PropertyCache::fullTest(JSContext *cx, jsbytecode *pc, JSObject **objp, JSObject **pobjp,
                         PropertyCacheEntry *entry)
@@ -242,13 +261,16 @@ void
 PropertyCache::assertEmpty()
 {
     JS_ASSERT(empty);
-    for (unsigned i = 0; i < SIZE; i++) {
-        JS_ASSERT(!table[i].kpc);
-        JS_ASSERT(!table[i].kshape);
-        JS_ASSERT(!table[i].pshape);
-        JS_ASSERT(!table[i].prop);
-        JS_ASSERT(!table[i].scopeIndex);
-        JS_ASSERT(!table[i].protoIndex);
+    for (unsigned i = 0; i < SETS; i++) {
+        for (unsigned j = 0; j < WAYS; j++) {
+            const PropertyCacheEntry &entry = table[i][j];
+            JS_ASSERT(!entry.kpc);
+            JS_ASSERT(!entry.kshape);
+            JS_ASSERT(!entry.pshape);
+            JS_ASSERT(!entry.prop);
+            JS_ASSERT(!entry.scopeIndex);
+            JS_ASSERT(!entry.protoIndex);
+        }
     }
 }
 #endif
@@ -319,12 +341,10 @@ PropertyCache::purge(JSRuntime *rt)
 }
 
 void
-PropertyCache::restore(PropertyCacheEntry *entry)
+PropertyCache::restore(PropertyCacheEntry *entry, const PropertyCacheEntry &saved)
 {
-    PropertyCacheEntry *entry2;
+    JS_ASSERT(size_t(entry - table[hash(saved.kpc, saved.kshape)]) < WAYS);
 
     empty = false;
-
-    entry2 = &table[hash(entry->kpc, entry->kshape)];
-    *entry2 = *entry;
+    *entry = saved;
 }
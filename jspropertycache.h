@@ -119,19 +119,44 @@ struct PropertyCacheEntry
 #define JS_PROPERTY_CACHE_METERING 1
 #endif
 
+#if defined DEBUG || defined JS_PROPERTY_CACHE_METERING
+#define JS_PROPERTY_CACHE_STATS 1
+#endif
+
+/*
+ * The cache is set-associative: (pc, shape) hashes to a set of WAYS entries,
+ * so a few hot sites that collide on a set no longer evict each other. Fills
+ * go to the front of the set and push older entries towards the back. The
+ * 2048 sets of 2 ways hold the same 4096 entries as the old direct-mapped
+ * table, so the cache's footprint is unchanged.
+ */
 class PropertyCache
 {
   private:
     enum {
-        SIZE_LOG2 = 12,
-        SIZE = JS_BIT(SIZE_LOG2),
-        MASK = JS_BITMASK(SIZE_LOG2)
+        SETS_LOG2 = 11,
+        SETS = JS_BIT(SETS_LOG2),
+        MASK = JS_BITMASK(SETS_LOG2),
+        WAYS = 2
     };
 
-    PropertyCacheEntry  table[SIZE];
+    PropertyCacheEntry  table[SETS][WAYS];
     JSBool              empty;
 
   public:
+#ifdef JS_PROPERTY_CACHE_STATS
+    /* Counters reported by the shell's propertyCacheStats function. */
+    struct Stats {
+        uint64_t        hits;           /* lookups satisfied by an entry */
+        uint64_t        misses;         /* lookups that found no usable entry */
+        uint64_t        evictions;      /* fills that displaced a live entry */
+    } stats;
+
+# define PCSTAT(x)      x
+#else
+# define PCSTAT(x)      ((void)0)
+#endif
+
 #ifdef JS_PROPERTY_CACHE_METERING
     PropertyCacheEntry  *pctestentry;   /* entry of the last PC-based test */
     uint32_t            fills;          /* number of cache entry fills */
@@ -177,9 +202,27 @@ class PropertyCache
     static inline uintptr_t
     hash(jsbytecode *pc, const Shape *kshape)
     {
-        return (((uintptr_t(pc) >> SIZE_LOG2) ^ uintptr_t(pc) ^ ((uintptr_t)kshape >> 3)) & MASK);
+        return (((uintptr_t(pc) >> SETS_LOG2) ^ uintptr_t(pc) ^ ((uintptr_t)kshape >> 3)) & MASK);
     }
 
+    /*
+     * Return the entry in the set for (pc, kshape) whose key matches, or the
+     * first entry of the set if there is none.
+     */
+    JS_ALWAYS_INLINE PropertyCacheEntry *
+    probe(jsbytecode *pc, const Shape *kshape)
+    {
+        PropertyCacheEntry *set = table[hash(pc, kshape)];
+        for (unsigned i = 0; i < WAYS; i++) {
+            if (set[i].kpc == pc && set[i].kshape == kshape)
+                return &set[i];
+        }
+        return set;
+    }
+
+    /* Pick the entry to overwrite with a fill for (pc, kshape). */
+    PropertyCacheEntry *entryForFill(jsbytecode *pc, const Shape *kshape);
+
     static inline bool matchShape(JSContext *cx, JSObject *obj, uint32_t shape);
 
     PropertyName *
@@ -222,7 +265,7 @@ class PropertyCache
     void purge(JSRuntime *rt);
 
     /* Restore an entry that may have been purged during a GC. */
-    void restore(PropertyCacheEntry *entry);
+    void restore(PropertyCacheEntry *entry, const PropertyCacheEntry &saved);
 };
 
 } /* namespace js */
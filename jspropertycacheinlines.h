@@ -68,7 +68,7 @@ js::PropertyCache::test(JSContext *cx, jsbytecode *pc, JSObject *&obj,
     JS_ASSERT(this == &JS_PROPERTY_CACHE(cx));
 
     const Shape *kshape = obj->lastProperty();
-    entry = &table[hash(pc, kshape)];
+    entry = probe(pc, kshape);
     PCMETER(pctestentry = entry);
     PCMETER(tests++);
     JS_ASSERT(&obj != &pobj);
@@ -83,13 +83,18 @@ js::PropertyCache::test(JSContext *cx, jsbytecode *pc, JSObject *&obj,
         if (pobj->lastProperty() == entry->pshape) {
             PCMETER(pchits++);
             PCMETER(entry->isOwnPropertyHit() || protopchits++);
+            PCSTAT(stats.hits++);
             name = NULL;
             return;
         }
     }
     name = fullTest(cx, pc, &obj, &pobj, entry);
-    if (name)
+    if (name) {
         PCMETER(misses++);
+        PCSTAT(stats.misses++);
+    } else {
+        PCSTAT(stats.hits++);
+    }
 }
 
 JS_ALWAYS_INLINE bool
@@ -99,19 +104,22 @@ js::PropertyCache::testForSet(JSContext *cx, jsbytecode *pc, JSObject *obj,
     JS_ASSERT(this == &JS_PROPERTY_CACHE(cx));
 
     const Shape *kshape = obj->lastProperty();
-    PropertyCacheEntry *entry = &table[hash(pc, kshape)];
+    PropertyCacheEntry *entry = probe(pc, kshape);
     *entryp = entry;
     PCMETER(pctestentry = entry);
     PCMETER(tests++);
     PCMETER(settests++);
-    if (entry->kpc == pc && entry->kshape == kshape)
+    if (entry->kpc == pc && entry->kshape == kshape) {
+        PCSTAT(stats.hits++);
         return true;
+    }
 
     PropertyName *name = fullTest(cx, pc, &obj, obj2p, entry);
     JS_ASSERT(name);
 
     PCMETER(misses++);
     PCMETER(setmisses++);
+    PCSTAT(stats.misses++);
 
     *namep = name;
     return false;
@@ -230,9 +230,11 @@ typedef struct JSTracer                     JSTracer;
 
 #ifdef __cplusplus
 class                                       JSFlatString;
+class                                       JSONStreamParser;
 class                                       JSString;
 #else
 typedef struct JSFlatString                 JSFlatString;
+typedef struct JSONStreamParser             JSONStreamParser;
 typedef struct JSString                     JSString;
 #endif /* !__cplusplus */
 
@@ -54,6 +54,12 @@
 
 #include <stdlib.h>
 #include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define JS_STRING_SSE2 1
+# include <emmintrin.h>
+#endif
+
 #include "jstypes.h"
 #include "jsutil.h"
 #include "jshash.h"
@@ -876,6 +882,95 @@ out_of_range:
     return true;
 }
 
+#ifdef JS_STRING_SSE2
+/*
+ * SSE2 kernels comparing eight jschars per step. The movemask of a 16-bit
+ * lane comparison sets two bits per lane, so a byte index is halved to get
+ * the char index.
+ */
+static JS_ALWAYS_INLINE __m128i
+LoadChars(const jschar *p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+#endif
+
+/* Return the index of the first c in text[0, textlen), or -1. */
+static JS_ALWAYS_INLINE int
+FirstCharMatch(const jschar *text, uint32_t textlen, jschar c)
+{
+    const jschar *t = text;
+    const jschar *end = text + textlen;
+#ifdef JS_STRING_SSE2
+    const __m128i pattern = _mm_set1_epi16(short(c));
+    for (; end - t >= 8; t += 8) {
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(LoadChars(t), pattern));
+        if (mask)
+            return (t - text) + (js_bitscan_ctz32(mask) >> 1);
+    }
+#endif
+    for (; t != end; ++t) {
+        if (*t == c)
+            return t - text;
+    }
+    return -1;
+}
+
+/* Return the index of the first position where s1 and s2 differ, or n. */
+static JS_ALWAYS_INLINE size_t
+FirstMismatch(const jschar *s1, const jschar *s2, size_t n)
+{
+    size_t i = 0;
+#ifdef JS_STRING_SSE2
+    for (; n - i >= 8; i += 8) {
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(LoadChars(s1 + i), LoadChars(s2 + i)));
+        if (mask != 0xFFFF)
+            return i + (js_bitscan_ctz32(~mask) >> 1);
+    }
+#endif
+    for (; i < n; i++) {
+        if (s1[i] != s2[i])
+            break;
+    }
+    return i;
+}
+
+#ifdef JS_STRING_SSE2
+/*
+ * Search for pat in text by testing eight candidate positions at once for
+ * both the first and the last character of the pattern, and comparing the
+ * characters in between only where both match.
+ */
+static int
+VectorMatch(const jschar *text, uint32_t textlen, const jschar *pat, uint32_t patlen)
+{
+    JS_ASSERT(patlen > 1 && textlen >= patlen);
+
+    const __m128i first = _mm_set1_epi16(short(pat[0]));
+    const __m128i last = _mm_set1_epi16(short(pat[patlen - 1]));
+    const uint32_t positions = textlen - patlen + 1;
+
+    uint32_t i = 0;
+    for (; positions - i >= 8; i += 8) {
+        __m128i firstEq = _mm_cmpeq_epi16(LoadChars(text + i), first);
+        __m128i lastEq = _mm_cmpeq_epi16(LoadChars(text + i + patlen - 1), last);
+        int mask = _mm_movemask_epi8(_mm_and_si128(firstEq, lastEq));
+        while (mask) {
+            int bit = js_bitscan_ctz32(mask);
+            uint32_t k = i + (bit >> 1);
+            if (FirstMismatch(text + k + 1, pat + 1, patlen - 2) == patlen - 2)
+                return k;
+            mask &= ~(3 << bit);
+        }
+    }
+    for (; i < positions; i++) {
+        if (text[i] == pat[0] && FirstMismatch(text + i + 1, pat + 1, patlen - 1) == patlen - 1)
+            return i;
+    }
+    return -1;
+}
+#endif
+
 /*
  * Boyer-Moore-Horspool superlinear search for pat:patlen in text:textlen.
  * The patlen argument must be positive and no greater than sBMHPatLenMax.
@@ -995,19 +1090,14 @@ StringMatch(const jschar *text, uint32_t textlen,
     if (textlen < patlen)
         return -1;
 
-#if defined(__i386__) || defined(_M_IX86) || defined(__i386)
+#if defined(JS_STRING_SSE2) || defined(__i386__) || defined(_M_IX86) || defined(__i386)
     /*
-     * Given enough registers, the unrolled loop below is faster than the
-     * following loop. 32-bit x86 does not have enough registers.
+     * Given enough registers, the unrolled loop below is faster than a
+     * scalar loop, but 32-bit x86 does not have enough registers. With SSE2
+     * the vector loop beats both.
      */
-    if (patlen == 1) {
-        const jschar p0 = *pat;
-        for (const jschar *c = text, *end = text + textlen; c != end; ++c) {
-            if (*c == p0)
-                return c - text;
-        }
-        return -1;
-    }
+    if (patlen == 1)
+        return FirstCharMatch(text, textlen, *pat);
 #endif
 
     /*
@@ -1029,6 +1119,9 @@ StringMatch(const jschar *text, uint32_t textlen,
             return index;
     }
 
+#ifdef JS_STRING_SSE2
+    return VectorMatch(text, textlen, pat, patlen);
+#else
     /*
      * For big patterns with large potential overlap we want the SIMD-optimized
      * speed of memcmp. For small patterns, a simple loop is faster.
@@ -1041,6 +1134,7 @@ StringMatch(const jschar *text, uint32_t textlen,
                         :
 #endif
                           UnrolledMatch<ManualCmp>(text, textlen, pat, patlen);
+#endif
 }
 
 static const size_t sRopeMatchThresholdRatioLog2 = 5;
@@ -3369,7 +3463,7 @@ EqualStrings(JSContext *cx, JSString *str1, JSString *str2, bool *result)
     if (!linear2)
         return false;
 
-    *result = PodEqual(linear1->chars(), linear2->chars(), length1);
+    *result = FirstMismatch(linear1->chars(), linear2->chars(), length1) == length1;
     return true;
 }
 
@@ -3383,7 +3477,7 @@ EqualStrings(JSLinearString *str1, JSLinearString *str2)
     if (length1 != str2->length())
         return false;
 
-    return PodEqual(str1->chars(), str2->chars(), length1);
+    return FirstMismatch(str1->chars(), str2->chars(), length1) == length1;
 }
 
 }  /* namespace js */
@@ -3409,7 +3503,10 @@ CompareStringsImpl(JSContext *cx, JSString *str1, JSString *str2, int32_t *resul
     if (!s2)
         return false;
 
-    return CompareChars(s1, str1->length(), s2, str2->length(), result);
+    /* Skip the common prefix a vector at a time. */
+    size_t l1 = str1->length(), l2 = str2->length();
+    size_t prefix = FirstMismatch(s1, s2, JS_MIN(l1, l2));
+    return CompareChars(s1 + prefix, l1 - prefix, s2 + prefix, l2 - prefix, result);
 }
 
 bool
@@ -3466,12 +3563,10 @@ js_strchr(const jschar *s, jschar c)
 jschar *
 js_strchr_limit(const jschar *s, jschar c, const jschar *limit)
 {
-    while (s < limit) {
-        if (*s == c)
-            return (jschar *)s;
-        s++;
-    }
-    return NULL;
+    if (s >= limit)
+        return NULL;
+    int index = FirstCharMatch(s, limit - s, c);
+    return index < 0 ? NULL : (jschar *)s + index;
 }
 
 namespace js {
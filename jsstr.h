@@ -219,10 +219,15 @@ js_strchr(const jschar *s, jschar c);
 extern jschar *
 js_strchr_limit(const jschar *s, jschar c, const jschar *limit);
 
+/*
+ * Unlike PodCopy, which moves runs shorter than 128 elements one at a time,
+ * always use memcpy: the C library copies a vector at a time, and rope
+ * flattening spends most of its time copying many short runs.
+ */
 static JS_ALWAYS_INLINE void
 js_strncpy(jschar *dst, const jschar *src, size_t nelem)
 {
-    return js::PodCopy(dst, src, nelem);
+    js_memcpy(dst, src, nelem * sizeof(jschar));
 }
 
 namespace js {
@@ -256,7 +256,7 @@ JSRope::flattenInternal(JSContext *maybecx)
             goto first_visit_node;
         }
         size_t len = left.length();
-        PodCopy(pos, left.d.u1.chars, len);
+        js_strncpy(pos, left.d.u1.chars, len);
         pos += len;
     }
     visit_right_child: {
@@ -268,7 +268,7 @@ JSRope::flattenInternal(JSContext *maybecx)
             goto first_visit_node;
         }
         size_t len = right.length();
-        PodCopy(pos, right.d.u1.chars, len);
+        js_strncpy(pos, right.d.u1.chars, len);
         pos += len;
     }
     finish_node: {
@@ -362,7 +362,7 @@ JSDependentString::undepend(JSContext *cx)
     if (!s)
         return NULL;
 
-    PodCopy(s, chars(), n);
+    js_strncpy(s, chars(), n);
     s[n] = 0;
 
     d.lengthAndFlags = buildLengthAndFlags(n, FIXED_FLAGS);